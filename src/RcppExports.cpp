@@ -5,6 +5,162 @@
 
 using namespace Rcpp;
 
+// cppBootstrapVowelSpace
+List cppBootstrapVowelSpace(NumericVector f1, NumericVector f2, int nrep, double conf, std::string method, int minvectors, int nblocks, double seed, int threads, bool vsd, double resolution, double gridres, double threshold, std::string vsdmethod);
+RcppExport SEXP _articulated_cppBootstrapVowelSpace(SEXP f1SEXP, SEXP f2SEXP, SEXP nrepSEXP, SEXP confSEXP, SEXP methodSEXP, SEXP minvectorsSEXP, SEXP nblocksSEXP, SEXP seedSEXP, SEXP threadsSEXP, SEXP vsdSEXP, SEXP resolutionSEXP, SEXP gridresSEXP, SEXP thresholdSEXP, SEXP vsdmethodSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< int >::type nrep(nrepSEXP);
+    Rcpp::traits::input_parameter< double >::type conf(confSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type minvectors(minvectorsSEXP);
+    Rcpp::traits::input_parameter< int >::type nblocks(nblocksSEXP);
+    Rcpp::traits::input_parameter< double >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type vsd(vsdSEXP);
+    Rcpp::traits::input_parameter< double >::type resolution(resolutionSEXP);
+    Rcpp::traits::input_parameter< double >::type gridres(gridresSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< std::string >::type vsdmethod(vsdmethodSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppBootstrapVowelSpace(f1, f2, nrep, conf, method, minvectors, nblocks, seed, threads, vsd, resolution, gridres, threshold, vsdmethod));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVowelDispersion
+List cppVowelDispersion(NumericVector f1, NumericVector f2, IntegerVector category, int ncategories, IntegerVector group, int ngroups, std::string method, int minvectors, int threads);
+RcppExport SEXP _articulated_cppVowelDispersion(SEXP f1SEXP, SEXP f2SEXP, SEXP categorySEXP, SEXP ncategoriesSEXP, SEXP groupSEXP, SEXP ngroupsSEXP, SEXP methodSEXP, SEXP minvectorsSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type category(categorySEXP);
+    Rcpp::traits::input_parameter< int >::type ncategories(ncategoriesSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type group(groupSEXP);
+    Rcpp::traits::input_parameter< int >::type ngroups(ngroupsSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type minvectors(minvectorsSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVowelDispersion(f1, f2, category, ncategories, group, ngroups, method, minvectors, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppGMM2
+List cppGMM2(NumericVector f2, NumericVector f1, int k, int restarts, int maxiter, double tol, int kmiter, double floor, double margin, int warmup, double seed, int threads);
+RcppExport SEXP _articulated_cppGMM2(SEXP f2SEXP, SEXP f1SEXP, SEXP kSEXP, SEXP restartsSEXP, SEXP maxiterSEXP, SEXP tolSEXP, SEXP kmiterSEXP, SEXP floorSEXP, SEXP marginSEXP, SEXP warmupSEXP, SEXP seedSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    Rcpp::traits::input_parameter< int >::type restarts(restartsSEXP);
+    Rcpp::traits::input_parameter< int >::type maxiter(maxiterSEXP);
+    Rcpp::traits::input_parameter< double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< int >::type kmiter(kmiterSEXP);
+    Rcpp::traits::input_parameter< double >::type floor(floorSEXP);
+    Rcpp::traits::input_parameter< double >::type margin(marginSEXP);
+    Rcpp::traits::input_parameter< int >::type warmup(warmupSEXP);
+    Rcpp::traits::input_parameter< double >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppGMM2(f2, f1, k, restarts, maxiter, tol, kmiter, floor, margin, warmup, seed, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppGMM2Online
+List cppGMM2Online(NumericVector f2, NumericVector f1, std::string file, int k, int chunk, int epochs, double decay, int kmiter, double floor, double threshold, double seed, int threads);
+RcppExport SEXP _articulated_cppGMM2Online(SEXP f2SEXP, SEXP f1SEXP, SEXP fileSEXP, SEXP kSEXP, SEXP chunkSEXP, SEXP epochsSEXP, SEXP decaySEXP, SEXP kmiterSEXP, SEXP floorSEXP, SEXP thresholdSEXP, SEXP seedSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    Rcpp::traits::input_parameter< int >::type chunk(chunkSEXP);
+    Rcpp::traits::input_parameter< int >::type epochs(epochsSEXP);
+    Rcpp::traits::input_parameter< double >::type decay(decaySEXP);
+    Rcpp::traits::input_parameter< int >::type kmiter(kmiterSEXP);
+    Rcpp::traits::input_parameter< double >::type floor(floorSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< double >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppGMM2Online(f2, f1, file, k, chunk, epochs, decay, kmiter, floor, threshold, seed, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppCVSASweep
+List cppCVSASweep(NumericVector f2, NumericVector f1, NumericVector loglik, NumericVector thresholds);
+RcppExport SEXP _articulated_cppCVSASweep(SEXP f2SEXP, SEXP f1SEXP, SEXP loglikSEXP, SEXP thresholdsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type loglik(loglikSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type thresholds(thresholdsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppCVSASweep(f2, f1, loglik, thresholds));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppConvexHull
+List cppConvexHull(NumericVector x, NumericVector y);
+RcppExport SEXP _articulated_cppConvexHull(SEXP xSEXP, SEXP ySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type y(ySEXP);
+    rcpp_result_gen = Rcpp::wrap(cppConvexHull(x, y));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppNormalizeFormants
+List cppNormalizeFormants(NumericVector f1, NumericVector f2, IntegerVector group, int ngroups, std::string method, bool vowelspace, std::string centermethod, int minvectors, int threads, bool vsd, double resolution, double gridres, double threshold, std::string vsdmethod);
+RcppExport SEXP _articulated_cppNormalizeFormants(SEXP f1SEXP, SEXP f2SEXP, SEXP groupSEXP, SEXP ngroupsSEXP, SEXP methodSEXP, SEXP vowelspaceSEXP, SEXP centermethodSEXP, SEXP minvectorsSEXP, SEXP threadsSEXP, SEXP vsdSEXP, SEXP resolutionSEXP, SEXP gridresSEXP, SEXP thresholdSEXP, SEXP vsdmethodSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type group(groupSEXP);
+    Rcpp::traits::input_parameter< int >::type ngroups(ngroupsSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< bool >::type vowelspace(vowelspaceSEXP);
+    Rcpp::traits::input_parameter< std::string >::type centermethod(centermethodSEXP);
+    Rcpp::traits::input_parameter< int >::type minvectors(minvectorsSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type vsd(vsdSEXP);
+    Rcpp::traits::input_parameter< double >::type resolution(resolutionSEXP);
+    Rcpp::traits::input_parameter< double >::type gridres(gridresSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< std::string >::type vsdmethod(vsdmethodSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppNormalizeFormants(f1, f2, group, ngroups, method, vowelspace, centermethod, minvectors, threads, vsd, resolution, gridres, threshold, vsdmethod));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVowelOverlap
+DataFrame cppVowelOverlap(NumericVector f1, NumericVector f2, IntegerVector category, int ncategories, IntegerVector group, int ngroups, IntegerVector pairA, IntegerVector pairB, int threads);
+RcppExport SEXP _articulated_cppVowelOverlap(SEXP f1SEXP, SEXP f2SEXP, SEXP categorySEXP, SEXP ncategoriesSEXP, SEXP groupSEXP, SEXP ngroupsSEXP, SEXP pairASEXP, SEXP pairBSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type category(categorySEXP);
+    Rcpp::traits::input_parameter< int >::type ncategories(ncategoriesSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type group(groupSEXP);
+    Rcpp::traits::input_parameter< int >::type ngroups(ngroupsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type pairA(pairASEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type pairB(pairBSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVowelOverlap(f1, f2, category, ncategories, group, ngroups, pairA, pairB, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // rPVI
 double rPVI(NumericVector x, bool narm);
 RcppExport SEXP _articulated_rPVI(SEXP xSEXP, SEXP narmSEXP) {
@@ -103,8 +259,312 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cppReadWav
+List cppReadWav(std::string file);
+RcppExport SEXP _articulated_cppReadWav(SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppReadWav(file));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppWavInfo
+List cppWavInfo(std::string file);
+RcppExport SEXP _articulated_cppWavInfo(SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppWavInfo(file));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVoiceFrames
+DataFrame cppVoiceFrames(NumericVector samples, double rate, double minf, double maxf, double shift, double window, double threshold, double fullscale, int threads);
+RcppExport SEXP _articulated_cppVoiceFrames(SEXP samplesSEXP, SEXP rateSEXP, SEXP minfSEXP, SEXP maxfSEXP, SEXP shiftSEXP, SEXP windowSEXP, SEXP thresholdSEXP, SEXP fullscaleSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type samples(samplesSEXP);
+    Rcpp::traits::input_parameter< double >::type rate(rateSEXP);
+    Rcpp::traits::input_parameter< double >::type minf(minfSEXP);
+    Rcpp::traits::input_parameter< double >::type maxf(maxfSEXP);
+    Rcpp::traits::input_parameter< double >::type shift(shiftSEXP);
+    Rcpp::traits::input_parameter< double >::type window(windowSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< double >::type fullscale(fullscaleSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVoiceFrames(samples, rate, minf, maxf, shift, window, threshold, fullscale, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVoiceRangeProfile
+DataFrame cppVoiceRangeProfile(List semitones, List levels, double stbin, double dbbin, int threads);
+RcppExport SEXP _articulated_cppVoiceRangeProfile(SEXP semitonesSEXP, SEXP levelsSEXP, SEXP stbinSEXP, SEXP dbbinSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type semitones(semitonesSEXP);
+    Rcpp::traits::input_parameter< List >::type levels(levelsSEXP);
+    Rcpp::traits::input_parameter< double >::type stbin(stbinSEXP);
+    Rcpp::traits::input_parameter< double >::type dbbin(dbbinSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVoiceRangeProfile(semitones, levels, stbin, dbbin, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVRPStreamNew
+SEXP cppVRPStreamNew(double rate, double minf, double maxf, double shift, double window, double threshold, double stbin, double dbbin, double fullscale);
+RcppExport SEXP _articulated_cppVRPStreamNew(SEXP rateSEXP, SEXP minfSEXP, SEXP maxfSEXP, SEXP shiftSEXP, SEXP windowSEXP, SEXP thresholdSEXP, SEXP stbinSEXP, SEXP dbbinSEXP, SEXP fullscaleSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< double >::type rate(rateSEXP);
+    Rcpp::traits::input_parameter< double >::type minf(minfSEXP);
+    Rcpp::traits::input_parameter< double >::type maxf(maxfSEXP);
+    Rcpp::traits::input_parameter< double >::type shift(shiftSEXP);
+    Rcpp::traits::input_parameter< double >::type window(windowSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< double >::type stbin(stbinSEXP);
+    Rcpp::traits::input_parameter< double >::type dbbin(dbbinSEXP);
+    Rcpp::traits::input_parameter< double >::type fullscale(fullscaleSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVRPStreamNew(rate, minf, maxf, shift, window, threshold, stbin, dbbin, fullscale));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVRPStreamAdd
+void cppVRPStreamAdd(SEXP stream, NumericVector samples, int threads);
+RcppExport SEXP _articulated_cppVRPStreamAdd(SEXP streamSEXP, SEXP samplesSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type samples(samplesSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    cppVRPStreamAdd(stream, samples, threads);
+    return R_NilValue;
+END_RCPP
+}
+// cppVRPStreamAddFile
+void cppVRPStreamAddFile(SEXP stream, std::string file, int block, int threads);
+RcppExport SEXP _articulated_cppVRPStreamAddFile(SEXP streamSEXP, SEXP fileSEXP, SEXP blockSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< int >::type block(blockSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    cppVRPStreamAddFile(stream, file, block, threads);
+    return R_NilValue;
+END_RCPP
+}
+// cppVRPStreamState
+List cppVRPStreamState(SEXP stream);
+RcppExport SEXP _articulated_cppVRPStreamState(SEXP streamSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVRPStreamState(stream));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVectorSpace
+List cppVectorSpace(NumericVector f1, NumericVector f2, double f1c, double f2c, int minvectors);
+RcppExport SEXP _articulated_cppVectorSpace(SEXP f1SEXP, SEXP f2SEXP, SEXP f1cSEXP, SEXP f2cSEXP, SEXP minvectorsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< double >::type f1c(f1cSEXP);
+    Rcpp::traits::input_parameter< double >::type f2c(f2cSEXP);
+    Rcpp::traits::input_parameter< int >::type minvectors(minvectorsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVectorSpace(f1, f2, f1c, f2c, minvectors));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVowelspaceCenter
+List cppVowelspaceCenter(NumericVector f1, NumericVector f2, std::string method, bool narm);
+RcppExport SEXP _articulated_cppVowelspaceCenter(SEXP f1SEXP, SEXP f2SEXP, SEXP methodSEXP, SEXP narmSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< bool >::type narm(narmSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVowelspaceCenter(f1, f2, method, narm));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppGroupedVectorSpace
+List cppGroupedVectorSpace(NumericVector f1, NumericVector f2, IntegerVector group, int ngroups, std::string method, int minvectors, int threads);
+RcppExport SEXP _articulated_cppGroupedVectorSpace(SEXP f1SEXP, SEXP f2SEXP, SEXP groupSEXP, SEXP ngroupsSEXP, SEXP methodSEXP, SEXP minvectorsSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type group(groupSEXP);
+    Rcpp::traits::input_parameter< int >::type ngroups(ngroupsSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type minvectors(minvectorsSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppGroupedVectorSpace(f1, f2, group, ngroups, method, minvectors, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppPolygonAreas
+NumericVector cppPolygonAreas(NumericVector x, NumericVector y, IntegerVector group, int ngroups);
+RcppExport SEXP _articulated_cppPolygonAreas(SEXP xSEXP, SEXP ySEXP, SEXP groupSEXP, SEXP ngroupsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type y(ySEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type group(groupSEXP);
+    Rcpp::traits::input_parameter< int >::type ngroups(ngroupsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppPolygonAreas(x, y, group, ngroups));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVowelspaceStreamNew
+SEXP cppVowelspaceStreamNew(std::string method, int minvectors, double tolerance);
+RcppExport SEXP _articulated_cppVowelspaceStreamNew(SEXP methodSEXP, SEXP minvectorsSEXP, SEXP toleranceSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type minvectors(minvectorsSEXP);
+    Rcpp::traits::input_parameter< double >::type tolerance(toleranceSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVowelspaceStreamNew(method, minvectors, tolerance));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVowelspaceStreamAdd
+void cppVowelspaceStreamAdd(SEXP stream, NumericVector f1, NumericVector f2);
+RcppExport SEXP _articulated_cppVowelspaceStreamAdd(SEXP streamSEXP, SEXP f1SEXP, SEXP f2SEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    cppVowelspaceStreamAdd(stream, f1, f2);
+    return R_NilValue;
+END_RCPP
+}
+// cppVowelspaceStreamState
+List cppVowelspaceStreamState(SEXP stream, bool rebin);
+RcppExport SEXP _articulated_cppVowelspaceStreamState(SEXP streamSEXP, SEXP rebinSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< bool >::type rebin(rebinSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVowelspaceStreamState(stream, rebin));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVSD
+DataFrame cppVSD(NumericVector f2, NumericVector f1, double resolution, double gridres, double threshold, std::string method);
+RcppExport SEXP _articulated_cppVSD(SEXP f2SEXP, SEXP f1SEXP, SEXP resolutionSEXP, SEXP gridresSEXP, SEXP thresholdSEXP, SEXP methodSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< double >::type resolution(resolutionSEXP);
+    Rcpp::traits::input_parameter< double >::type gridres(gridresSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVSD(f2, f1, resolution, gridres, threshold, method));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVSDSweep
+DataFrame cppVSDSweep(NumericVector f2, NumericVector f1, NumericVector gridres, NumericVector radii, NumericVector thresholds);
+RcppExport SEXP _articulated_cppVSDSweep(SEXP f2SEXP, SEXP f1SEXP, SEXP gridresSEXP, SEXP radiiSEXP, SEXP thresholdsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type gridres(gridresSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type radii(radiiSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type thresholds(thresholdsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVSDSweep(f2, f1, gridres, radii, thresholds));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppGroupedVSD
+List cppGroupedVSD(NumericVector f2, NumericVector f1, IntegerVector group, int ngroups, NumericVector grid, double resolution, double threshold, std::string method, int threads);
+RcppExport SEXP _articulated_cppGroupedVSD(SEXP f2SEXP, SEXP f1SEXP, SEXP groupSEXP, SEXP ngroupsSEXP, SEXP gridSEXP, SEXP resolutionSEXP, SEXP thresholdSEXP, SEXP methodSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type group(groupSEXP);
+    Rcpp::traits::input_parameter< int >::type ngroups(ngroupsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type grid(gridSEXP);
+    Rcpp::traits::input_parameter< double >::type resolution(resolutionSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppGroupedVSD(f2, f1, group, ngroups, grid, resolution, threshold, method, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVSDStreamNew
+SEXP cppVSDStreamNew(NumericVector grid, double resolution, double threshold, double tolerance);
+RcppExport SEXP _articulated_cppVSDStreamNew(SEXP gridSEXP, SEXP resolutionSEXP, SEXP thresholdSEXP, SEXP toleranceSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type grid(gridSEXP);
+    Rcpp::traits::input_parameter< double >::type resolution(resolutionSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< double >::type tolerance(toleranceSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVSDStreamNew(grid, resolution, threshold, tolerance));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cppVSDStreamAdd
+void cppVSDStreamAdd(SEXP stream, NumericVector f2, NumericVector f1);
+RcppExport SEXP _articulated_cppVSDStreamAdd(SEXP streamSEXP, SEXP f2SEXP, SEXP f1SEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f2(f2SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type f1(f1SEXP);
+    cppVSDStreamAdd(stream, f2, f1);
+    return R_NilValue;
+END_RCPP
+}
+// cppVSDStreamState
+List cppVSDStreamState(SEXP stream, bool recompute);
+RcppExport SEXP _articulated_cppVSDStreamState(SEXP streamSEXP, SEXP recomputeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< bool >::type recompute(recomputeSEXP);
+    rcpp_result_gen = Rcpp::wrap(cppVSDStreamState(stream, recompute));
+    return rcpp_result_gen;
+END_RCPP
+}
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_articulated_cppBootstrapVowelSpace", (DL_FUNC) &_articulated_cppBootstrapVowelSpace, 14},
+    {"_articulated_cppVowelDispersion", (DL_FUNC) &_articulated_cppVowelDispersion, 9},
+    {"_articulated_cppGMM2", (DL_FUNC) &_articulated_cppGMM2, 12},
+    {"_articulated_cppGMM2Online", (DL_FUNC) &_articulated_cppGMM2Online, 12},
+    {"_articulated_cppCVSASweep", (DL_FUNC) &_articulated_cppCVSASweep, 4},
+    {"_articulated_cppConvexHull", (DL_FUNC) &_articulated_cppConvexHull, 2},
+    {"_articulated_cppNormalizeFormants", (DL_FUNC) &_articulated_cppNormalizeFormants, 14},
+    {"_articulated_cppVowelOverlap", (DL_FUNC) &_articulated_cppVowelOverlap, 9},
     {"_articulated_rPVI", (DL_FUNC) &_articulated_rPVI, 2},
     {"_articulated_nPVI", (DL_FUNC) &_articulated_nPVI, 2},
     {"_articulated_jitter_local", (DL_FUNC) &_articulated_jitter_local, 5},
@@ -112,6 +572,27 @@ static const R_CallMethodDef CallEntries[] = {
     {"_articulated_jitter_rap", (DL_FUNC) &_articulated_jitter_rap, 5},
     {"_articulated_jitter_ppq5", (DL_FUNC) &_articulated_jitter_ppq5, 5},
     {"_articulated_cppRelstab", (DL_FUNC) &_articulated_cppRelstab, 4},
+    {"_articulated_cppReadWav", (DL_FUNC) &_articulated_cppReadWav, 1},
+    {"_articulated_cppWavInfo", (DL_FUNC) &_articulated_cppWavInfo, 1},
+    {"_articulated_cppVoiceFrames", (DL_FUNC) &_articulated_cppVoiceFrames, 9},
+    {"_articulated_cppVoiceRangeProfile", (DL_FUNC) &_articulated_cppVoiceRangeProfile, 5},
+    {"_articulated_cppVRPStreamNew", (DL_FUNC) &_articulated_cppVRPStreamNew, 9},
+    {"_articulated_cppVRPStreamAdd", (DL_FUNC) &_articulated_cppVRPStreamAdd, 3},
+    {"_articulated_cppVRPStreamAddFile", (DL_FUNC) &_articulated_cppVRPStreamAddFile, 4},
+    {"_articulated_cppVRPStreamState", (DL_FUNC) &_articulated_cppVRPStreamState, 1},
+    {"_articulated_cppVectorSpace", (DL_FUNC) &_articulated_cppVectorSpace, 5},
+    {"_articulated_cppVowelspaceCenter", (DL_FUNC) &_articulated_cppVowelspaceCenter, 4},
+    {"_articulated_cppGroupedVectorSpace", (DL_FUNC) &_articulated_cppGroupedVectorSpace, 7},
+    {"_articulated_cppPolygonAreas", (DL_FUNC) &_articulated_cppPolygonAreas, 4},
+    {"_articulated_cppVowelspaceStreamNew", (DL_FUNC) &_articulated_cppVowelspaceStreamNew, 3},
+    {"_articulated_cppVowelspaceStreamAdd", (DL_FUNC) &_articulated_cppVowelspaceStreamAdd, 3},
+    {"_articulated_cppVowelspaceStreamState", (DL_FUNC) &_articulated_cppVowelspaceStreamState, 2},
+    {"_articulated_cppVSD", (DL_FUNC) &_articulated_cppVSD, 6},
+    {"_articulated_cppVSDSweep", (DL_FUNC) &_articulated_cppVSDSweep, 5},
+    {"_articulated_cppGroupedVSD", (DL_FUNC) &_articulated_cppGroupedVSD, 9},
+    {"_articulated_cppVSDStreamNew", (DL_FUNC) &_articulated_cppVSDStreamNew, 4},
+    {"_articulated_cppVSDStreamAdd", (DL_FUNC) &_articulated_cppVSDStreamAdd, 3},
+    {"_articulated_cppVSDStreamState", (DL_FUNC) &_articulated_cppVSDStreamState, 2},
     {NULL, NULL, 0}
 };
 
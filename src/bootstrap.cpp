@@ -0,0 +1,215 @@
+#include <Rcpp.h>
+#include "vowelspace.h"
+#include "bootstrap.h"
+#include "vowelspace_rcpp.h"
+#include "vsd.h"
+#include "vsd_grouped.h"
+#include "vsd_rcpp.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// The vowel space center and VSA of a set of resampled vowels, and
+// optionally the area of their VSD (see vsd_of_tokens()). The VSD is
+// computed in the workspace of the calling thread.
+struct VowelSpaceStatistic {
+  const double* f1;
+  const double* f2;
+  CenterMethod method;
+  int minvectors;
+
+  bool vsd;
+  const double* grid;
+  int m;
+  double resolution, threshold;
+  bool smooth;
+  DensityKernel kernel;
+  std::vector<VSDWorkspace>* workspaces;
+
+  int values() const {
+    return vsd ? 4 : 3;
+  }
+
+  void operator()(const std::size_t* index, std::size_t n, Arena& arena,
+                  double* out) const {
+    IndexedTokens tok(f1, f2, index);
+    arena.reset(2 * Arena::bytes_for<double>(n) + Arena::bytes_for<int>(n));
+    double* norms = arena.alloc<double>(n);
+    double* angles = arena.alloc<double>(n);
+    int* corner = arena.alloc<int>(n);
+
+    Center c = vowel_space_center(tok, n, method);
+    CornerSet cs;
+    vowel_space(tok, n, c.f1, c.f2, minvectors, norms, angles, corner, cs);
+    double areas[N_CORNERS];
+    int nareas;
+    double vsa;
+    corner_areas(cs, areas, nareas, vsa);
+
+    out[0] = c.f2;
+    out[1] = c.f1;
+    out[2] = vsa;
+    if(vsd) {
+      GroupVSD res;
+      vsd_of_tokens(f1, f2, index, n, grid, m, grid[0], grid[m - 1],
+                    resolution, threshold, smooth, kernel,
+                    (*workspaces)[thread_id()], res);
+      out[3] = res.area;
+    }
+  }
+};
+
+// Type 7 quantile (the default of quantile()) of sorted values.
+static double sorted_quantile(const std::vector<double>& x, double p) {
+  if(x.empty() || std::isnan(p)) return R_NaReal;
+  double h = (x.size() - 1) * p;
+  std::size_t lo = (std::size_t) std::floor(h);
+  std::size_t hi = std::min(lo + 1, x.size() - 1);
+  return x[lo] + (h - lo) * (x[hi] - x[lo]);
+}
+
+// Native backend of vowelspace.boot(). Returns the estimates, the
+// replicates and percentile and BCa intervals of each statistic. With
+// vsd = true the VSD area over the grid seq(-1 + gridres/2, 1.5, gridres)
+// is resampled as well.
+// [[Rcpp::export]]
+List cppBootstrapVowelSpace(NumericVector f1,
+                            NumericVector f2,
+                            int nrep = 2000,
+                            double conf = 0.95,
+                            std::string method = "wcentroid",
+                            int minvectors = 3,
+                            int nblocks = 100,
+                            double seed = 1,
+                            int threads = 0,
+                            bool vsd = false,
+                            double resolution = 0.05,
+                            double gridres = 0.01,
+                            double threshold = 0.25,
+                            std::string vsdmethod = "count") {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  if(nrep < 1) {
+    Rcpp::stop("At least one bootstrap replicate is needed.");
+  }
+  if(!(conf > 0 && conf < 1)) {
+    Rcpp::stop("The confidence level must be between 0 and 1.");
+  }
+  bool smooth = false;
+  DensityKernel kernel = KERNEL_GAUSSIAN;
+  if(vsd) {
+    if(!(gridres > 0 && gridres < 2.5)) {
+      Rcpp::stop("The grid resolution must be positive and below 2.5.");
+    }
+    vsd_method(vsdmethod, resolution, smooth, kernel);
+  }
+  int nthreads = resolve_threads(threads);
+  UniformGrid ug(-1 + gridres / 2, 1.5, gridres);
+  std::vector<double> grid(vsd ? ug.m : 0);
+  for(std::size_t i = 0; i < grid.size(); ++i) {
+    grid[i] = ug[i];
+  }
+  std::vector<VSDWorkspace> workspaces(vsd ? nthreads : 0);
+
+  VowelSpaceStatistic stat;
+  stat.f1 = f1.begin();
+  stat.f2 = f2.begin();
+  stat.method = center_method(method);
+  stat.minvectors = minvectors;
+  stat.vsd = vsd;
+  stat.grid = grid.data();
+  stat.m = grid.size();
+  stat.resolution = resolution;
+  stat.threshold = threshold;
+  stat.smooth = smooth;
+  stat.kernel = kernel;
+  stat.workspaces = &workspaces;
+
+  const int nstat = stat.values();
+  std::size_t n = f1.size();
+  nblocks = std::max(2, std::min(nblocks, (int) n));
+
+  std::vector<std::size_t> all(n);
+  for(std::size_t i = 0; i < n; ++i) {
+    all[i] = i;
+  }
+  Arena arena;
+  std::vector<double> estimate(nstat);
+  stat(all.data(), n, arena, estimate.data());
+
+  NumericMatrix reps(nrep, nstat);
+  bootstrap(stat, n, nstat, nrep, (std::uint64_t) seed, nthreads, reps.begin());
+  std::vector<double> jack((std::size_t) nblocks * nstat);
+  block_jackknife(stat, n, nstat, nblocks, nthreads, jack.data());
+
+  double alpha = (1 - conf) / 2;
+  double zlo = R::qnorm(alpha, 0, 1, 1, 0);
+  double zhi = -zlo;
+  NumericVector est(nstat), percLo(nstat), percHi(nstat), bcaLo(nstat), bcaHi(nstat);
+  IntegerVector valid(nstat);
+  for(int k = 0; k < nstat; ++k) {
+    const double* col = reps.begin() + (std::size_t) k * nrep;
+    std::vector<double> sorted;
+    sorted.reserve(nrep);
+    std::size_t below = 0;
+    for(int r = 0; r < nrep; ++r) {
+      if(std::isnan(col[r])) continue;
+      sorted.push_back(col[r]);
+      if(col[r] < estimate[k]) ++below;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    est[k] = estimate[k];
+    valid[k] = sorted.size();
+    percLo[k] = sorted_quantile(sorted, alpha);
+    percHi[k] = sorted_quantile(sorted, 1 - alpha);
+
+    // Bias correction from the replicates, acceleration from the jackknife.
+    double z0 = R::qnorm((double) below / sorted.size(), 0, 1, 1, 0);
+    const double* jk = jack.data() + (std::size_t) k * nblocks;
+    double jmean = 0;
+    int nj = 0;
+    for(int b = 0; b < nblocks; ++b) {
+      if(std::isnan(jk[b])) continue;
+      jmean += jk[b];
+      ++nj;
+    }
+    jmean /= nj;
+    double num = 0, den = 0;
+    for(int b = 0; b < nblocks; ++b) {
+      if(std::isnan(jk[b])) continue;
+      double d = jmean - jk[b];
+      num += d * d * d;
+      den += d * d;
+    }
+    double a = den > 0 ? num / (6 * std::pow(den, 1.5)) : 0;
+    if(std::isnan(estimate[k]) || sorted.empty() || !std::isfinite(z0) || nj < 2) {
+      bcaLo[k] = R_NaReal;
+      bcaHi[k] = R_NaReal;
+    } else {
+      double plo = R::pnorm(z0 + (z0 + zlo) / (1 - a * (z0 + zlo)), 0, 1, 1, 0);
+      double phi = R::pnorm(z0 + (z0 + zhi) / (1 - a * (z0 + zhi)), 0, 1, 1, 0);
+      bcaLo[k] = sorted_quantile(sorted, plo);
+      bcaHi[k] = sorted_quantile(sorted, phi);
+    }
+  }
+
+  CharacterVector names = vsd ?
+    CharacterVector::create("F2 center", "F1 center", "VSA", "VSD") :
+    CharacterVector::create("F2 center", "F1 center", "VSA");
+  reps.attr("dimnames") = List::create(R_NilValue, names);
+  DataFrame intervals = DataFrame::create(Named("statistic") = names,
+                                          Named("estimate") = est,
+                                          Named("replicates") = valid,
+                                          Named("perc.lower") = percLo,
+                                          Named("perc.upper") = percHi,
+                                          Named("bca.lower") = bcaLo,
+                                          Named("bca.upper") = bcaHi,
+                                          Named("stringsAsFactors") = false);
+  return List::create(Named("Intervals") = intervals,
+                      Named("Replicates") = reps);
+}
@@ -0,0 +1,124 @@
+#ifndef ARTICULATED_BOOTSTRAP_H
+#define ARTICULATED_BOOTSTRAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "parallel.h"
+
+// A bootstrap engine for statistics computed over a set of tokens. A
+// statistic is a function object called as
+//
+//   stat(index, n, arena, out)
+//
+// which computes its values from the n tokens listed in index and writes
+// them to out. The tokens themselves are never copied; a replicate is just a
+// vector of resampled token indices.
+
+namespace articulated {
+
+// xoshiro256** seeded through splitmix64. Every replicate gets its own
+// stream, derived from the seed and the replicate number, so the results do
+// not depend on the number of threads or on how replicates are scheduled.
+class Rng {
+public:
+  Rng(std::uint64_t seed, std::uint64_t stream) {
+    std::uint64_t x = seed ^ (0x9E3779B97F4A7C15ULL * (stream + 1));
+    for(int i = 0; i < 4; ++i) {
+      s[i] = splitmix64(x);
+    }
+  }
+
+  std::uint64_t next() {
+    std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+    std::uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+  }
+
+  // A uniform number in [0,1) with 53 bits of precision.
+  double uniform() {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  // A uniform integer in 0..n-1.
+  std::size_t below(std::size_t n) {
+    return (std::size_t) (uniform() * n);
+  }
+
+private:
+  std::uint64_t s[4];
+
+  static std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  static std::uint64_t splitmix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+};
+
+// Computes nrep bootstrap replicates of a statistic with nstat values over n
+// tokens. The replicates are written column major into reps, which must hold
+// nrep * nstat values (one column per value of the statistic).
+template <typename Stat>
+void bootstrap(const Stat& stat, std::size_t n, int nstat, int nrep,
+               std::uint64_t seed, int threads, double* reps) {
+#pragma omp parallel num_threads(threads)
+{
+  Arena arena;
+  std::vector<std::size_t> index(n);
+  std::vector<double> values(nstat);
+#pragma omp for schedule(dynamic)
+  for(int r = 0; r < nrep; ++r) {
+    Rng rng(seed, r);
+    for(std::size_t i = 0; i < n; ++i) {
+      index[i] = rng.below(n);
+    }
+    stat(index.data(), n, arena, values.data());
+    for(int k = 0; k < nstat; ++k) {
+      reps[r + (std::size_t) k * nrep] = values[k];
+    }
+  }
+}
+}
+
+// Computes delete-a-group jackknife estimates of a statistic, used for the
+// acceleration of BCa intervals. Token i belongs to group i % nblocks, so
+// that each group is an even sample of the tokens also when they are sorted
+// by vowel or speaker. The estimates are written column major into out,
+// which must hold nblocks * nstat values.
+template <typename Stat>
+void block_jackknife(const Stat& stat, std::size_t n, int nstat, int nblocks,
+                     int threads, double* out) {
+#pragma omp parallel num_threads(threads)
+{
+  Arena arena;
+  std::vector<std::size_t> index(n);
+  std::vector<double> values(nstat);
+#pragma omp for schedule(dynamic)
+  for(int b = 0; b < nblocks; ++b) {
+    std::size_t m = 0;
+    for(std::size_t i = 0; i < n; ++i) {
+      if(i % nblocks != (std::size_t) b) index[m++] = i;
+    }
+    stat(index.data(), m, arena, values.data());
+    for(int k = 0; k < nstat; ++k) {
+      out[b + (std::size_t) k * nblocks] = values[k];
+    }
+  }
+}
+}
+
+} // namespace articulated
+
+#endif
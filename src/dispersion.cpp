@@ -0,0 +1,80 @@
+#include <Rcpp.h>
+#include "dispersion.h"
+#include "parallel.h"
+#include "vowelspace_rcpp.h"
+#include <string>
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// Native backend of vowel.dispersion(). Returns the vowel space tables of
+// vector.space.by() with the FCR and VAI added to the centers, the
+// dispersion of every category present in a group and the dispersion of
+// every vowel. Groups and categories are given by their 1-based codes.
+// [[Rcpp::export]]
+List cppVowelDispersion(NumericVector f1,
+                        NumericVector f2,
+                        IntegerVector category,
+                        int ncategories,
+                        IntegerVector group,
+                        int ngroups,
+                        std::string method = "wcentroid",
+                        int minvectors = 3,
+                        int threads = 0) {
+  if(f1.size() != f2.size() || f1.size() != category.size() ||
+     f1.size() != group.size()) {
+    Rcpp::stop("The F1, F2, vowel and group vectors must be of the same length.");
+  }
+  std::size_t n = f1.size();
+  GroupIndex gi(group.begin(), n, ngroups);
+  GroupedVowelSpace vs;
+  std::vector<CategoryDispersion> cats((std::size_t) ngroups * ncategories);
+  NumericVector fcr(ngroups), vai(ngroups);
+  NumericVector dispersion(n);
+  grouped_dispersion(f1.begin(), f2.begin(), category.begin(), ncategories, gi,
+                     n, center_method(method), minvectors,
+                     resolve_threads(threads), vs, cats.data(), fcr.begin(),
+                     dispersion.begin());
+  for(int g = 0; g < ngroups; ++g) {
+    vai[g] = 1 / fcr[g];
+  }
+
+  List vsList = grouped_vowel_space_list(gi, vs);
+  DataFrame centers = vsList["Centers"];
+  centers.push_back(fcr, "fcr");
+  centers.push_back(vai, "vai");
+  DataFrame corners = vsList["Corner vowels"];
+
+  int nrows = 0;
+  for(std::size_t r = 0; r < cats.size(); ++r) {
+    if(cats[r].n > 0) ++nrows;
+  }
+  IntegerVector cgroup(nrows), cvowel(nrows), cn(nrows);
+  NumericVector cf2(nrows), cf1(nrows), cmean(nrows), csd(nrows), cdist(nrows);
+  for(std::size_t r = 0, k = 0; r < cats.size(); ++r) {
+    const CategoryDispersion& cd = cats[r];
+    if(cd.n == 0) continue;
+    cgroup[k] = r / ncategories + 1;
+    cvowel[k] = r % ncategories + 1;
+    cn[k] = cd.n;
+    cf2[k] = cd.f2;
+    cf1[k] = cd.f1;
+    cmean[k] = cd.dispersion.value();
+    csd[k] = cd.dispersion.sd();
+    cdist[k] = cd.centerDistance;
+    ++k;
+  }
+  DataFrame categories = DataFrame::create(Named("group") = cgroup,
+                                           Named("vowel") = cvowel,
+                                           Named("n") = cn,
+                                           Named("f2") = cf2,
+                                           Named("f1") = cf1,
+                                           Named("dispersion") = cmean,
+                                           Named("dispersion.sd") = csd,
+                                           Named("center.distance") = cdist);
+  return List::create(Named("Centers") = centers,
+                      Named("Corner vowels") = corners,
+                      Named("Categories") = categories,
+                      Named("Dispersion") = dispersion);
+}
@@ -0,0 +1,133 @@
+#ifndef ARTICULATED_DISPERSION_H
+#define ARTICULATED_DISPERSION_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "matrix2.h"
+#include "normalize.h"
+#include "parallel.h"
+#include "vowelspace.h"
+#include "vowelspace_grouped.h"
+
+// Within-category formant dispersion and the formant centralization ratio
+// (FCR) and vowel articulation index (VAI) of groups of vowels.
+
+namespace articulated {
+
+// The centroid of a vowel category and the dispersion of its vowels, that
+// is, the distances of the vowels to the centroid.
+struct CategoryDispersion {
+  std::size_t n;
+  double f2, f1;
+  Moments dispersion;
+  // The distance from the vowel space center to the centroid
+  double centerDistance;
+};
+
+// The FCR (Sapir et al., 2010) of a vowel space,
+//
+//   FCR = (F2u + F2a + F1i + F1u) / (F2i + F1a),
+//
+// computed from the [u], [i] and [a] corner vowels. The VAI is its inverse.
+// Both are missing unless all three corners are present.
+inline double formant_centralization(const CornerSet& cs) {
+  double uF1 = na_real(), uF2 = na_real(), iF1 = na_real(), iF2 = na_real();
+  double aF1 = na_real(), aF2 = na_real();
+  for(int k = 0; k < cs.n; ++k) {
+    switch(cs.which[k]) {
+    case 0: uF1 = cs.f1[k]; uF2 = cs.f2[k]; break;
+    case 1: iF1 = cs.f1[k]; iF2 = cs.f2[k]; break;
+    case 3: aF1 = cs.f1[k]; aF2 = cs.f2[k]; break;
+    }
+  }
+  return (uF2 + aF2 + iF1 + uF1) / (iF2 + aF1);
+}
+
+// Computes the vowel space and the category dispersions of every group.
+// Categories and groups are given by 1-based codes, and the groups are
+// processed in parallel.
+//
+// Each group is gathered into the arena of its thread together with the
+// category sums (the first pass), from which the centroids follow. The
+// center and corners are computed on the gathered formants, exactly as for
+// vector.space.by(). The second pass measures the distance of each vowel to
+// its centroid and accumulates the mean and standard deviation of the
+// distances per category.
+//
+// cats must hold ngroups * ncategories results, stored group by group, fcr
+// must hold ngroups values, and dispersion one value per token. Tokens
+// without a group or category get a missing dispersion.
+inline void grouped_dispersion(const double* f1, const double* f2,
+                               const int* category, int ncategories,
+                               const GroupIndex& gi, std::size_t n,
+                               CenterMethod method, int minvectors,
+                               int threads, GroupedVowelSpace& vs,
+                               CategoryDispersion* cats, double* fcr,
+                               double* dispersion) {
+  int ngroups = gi.ngroups();
+  vs.centers.resize(ngroups);
+  vs.corners.resize(ngroups);
+  vs.vsa.resize(ngroups);
+  for(std::size_t i = 0; i < n; ++i) {
+    dispersion[i] = na_real();
+  }
+
+#pragma omp parallel num_threads(threads)
+{
+  Arena arena;
+  std::vector<Moments2> centroids(ncategories);
+#pragma omp for schedule(dynamic)
+  for(int g = 0; g < ngroups; ++g) {
+    std::size_t m = gi.size(g);
+    arena.reset(4 * Arena::bytes_for<double>(m) + 2 * Arena::bytes_for<int>(m));
+    double* gf1 = arena.alloc<double>(m);
+    double* gf2 = arena.alloc<double>(m);
+    double* norms = arena.alloc<double>(m);
+    double* angles = arena.alloc<double>(m);
+    int* corner = arena.alloc<int>(m);
+    int* gcat = arena.alloc<int>(m);
+    const std::size_t* idx = gi.index.data() + gi.offset[g];
+
+    centroids.assign(ncategories, Moments2());
+    for(std::size_t i = 0; i < m; ++i) {
+      gf1[i] = f1[idx[i]];
+      gf2[i] = f2[idx[i]];
+      int c = category[idx[i]] - 1;
+      gcat[i] = c >= 0 && c < ncategories ? c : -1;
+      if(gcat[i] >= 0) centroids[c].add(gf2[i], gf1[i]);
+    }
+
+    Center& center = vs.centers[g];
+    center = vowel_space_center(gf1, gf2, m, method);
+    vowel_space(gf1, gf2, m, center.f1, center.f2, minvectors, norms, angles,
+                corner, vs.corners[g]);
+    double areas[N_CORNERS];
+    int nareas;
+    corner_areas(vs.corners[g], areas, nareas, vs.vsa[g]);
+    fcr[g] = formant_centralization(vs.corners[g]);
+
+    CategoryDispersion* gcats = cats + (std::size_t) g * ncategories;
+    for(int c = 0; c < ncategories; ++c) {
+      CategoryDispersion& cd = gcats[c];
+      cd.n = centroids[c].n;
+      cd.f2 = cd.n > 0 ? centroids[c].mx : na_real();
+      cd.f1 = cd.n > 0 ? centroids[c].my : na_real();
+      cd.dispersion = Moments();
+      cd.centerDistance = std::hypot(cd.f2 - center.f2, cd.f1 - center.f1);
+    }
+    for(std::size_t i = 0; i < m; ++i) {
+      int c = gcat[i];
+      if(c < 0) continue;
+      double d = std::hypot(gf2[i] - gcats[c].f2, gf1[i] - gcats[c].f1);
+      dispersion[idx[i]] = d;
+      gcats[c].dispersion.add(d);
+    }
+  }
+}
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef ARTICULATED_FFT_H
+#define ARTICULATED_FFT_H
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// An iterative radix-2 fast Fourier transform. A plan holds the twiddle
+// factors and the bit reversal permutation of one transform size and is
+// read-only once made, so one plan can be shared by all threads, each
+// transforming its own buffers.
+
+namespace articulated {
+
+class FFT {
+public:
+  typedef std::complex<double> Complex;
+
+  // A plan for transforms of the smallest power of two >= n.
+  explicit FFT(std::size_t n = 1) : n(1) {
+    while(this->n < n) this->n <<= 1;
+    std::size_t bitsn = 0;
+    while(((std::size_t) 1 << bitsn) < this->n) ++bitsn;
+    reversed.resize(this->n);
+    for(std::size_t i = 0; i < this->n; ++i) {
+      std::size_t r = 0;
+      for(std::size_t b = 0; b < bitsn; ++b) {
+        if(i & ((std::size_t) 1 << b)) r |= (std::size_t) 1 << (bitsn - 1 - b);
+      }
+      reversed[i] = r;
+    }
+    twiddle.resize(this->n / 2);
+    const double pi = 3.14159265358979323846;
+    for(std::size_t k = 0; k < this->n / 2; ++k) {
+      twiddle[k] = std::polar(1.0, -2 * pi * k / this->n);
+    }
+  }
+
+  std::size_t size() const {
+    return n;
+  }
+
+  // Transforms a buffer of size() values in place. The inverse transform
+  // is not scaled by 1 / size().
+  void transform(Complex* x, bool inverse) const {
+    for(std::size_t i = 0; i < n; ++i) {
+      if(i < reversed[i]) std::swap(x[i], x[reversed[i]]);
+    }
+    for(std::size_t len = 2; len <= n; len <<= 1) {
+      std::size_t half = len / 2, step = n / len;
+      for(std::size_t i = 0; i < n; i += len) {
+        for(std::size_t k = 0; k < half; ++k) {
+          Complex w = inverse ? std::conj(twiddle[k * step]) : twiddle[k * step];
+          Complex t = w * x[i + k + half];
+          x[i + k + half] = x[i + k] - t;
+          x[i + k] += t;
+        }
+      }
+    }
+  }
+
+private:
+  std::size_t n;
+  std::vector<std::size_t> reversed;
+  std::vector<Complex> twiddle;
+};
+
+} // namespace articulated
+
+#endif
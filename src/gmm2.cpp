@@ -0,0 +1,271 @@
+#include <Rcpp.h>
+#include "gmm2.h"
+#include "gmm2_online.h"
+#include "hull.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// The parameters of a model as returned to R: the component weights, the
+// centroids and the covariance matrices (as variance of F2, covariance and
+// variance of F1), one row per component.
+static NumericVector model_weights(const GMM2& model) {
+  return NumericVector(model.weight.begin(), model.weight.end());
+}
+
+static NumericMatrix model_centroids(const GMM2& model) {
+  NumericMatrix out(model.k, 2);
+  for(int j = 0; j < model.k; ++j) {
+    out(j, 0) = model.mx[j];
+    out(j, 1) = model.my[j];
+  }
+  out.attr("dimnames") = List::create(R_NilValue,
+                                      CharacterVector::create("F2", "F1"));
+  return out;
+}
+
+static NumericMatrix model_covariances(const GMM2& model) {
+  NumericMatrix out(model.k, 3);
+  for(int j = 0; j < model.k; ++j) {
+    out(j, 0) = model.sxx[j];
+    out(j, 1) = model.sxy[j];
+    out(j, 2) = model.syy[j];
+  }
+  out.attr("dimnames") = List::create(R_NilValue,
+                                      CharacterVector::create("F2", "F2.F1", "F1"));
+  return out;
+}
+
+// Native 2-D Gaussian mixture model used by cVSA(). Frames with a missing
+// formant are left out of the fit and get a missing log-likelihood. The
+// model is fitted from 'restarts' k-means++ starting points (see
+// gmm2_multistart()), and the best one is kept. Returns the model
+// parameters, the total log-likelihood and the log mixture density of every
+// frame, and a summary of the restarts.
+// [[Rcpp::export]]
+List cppGMM2(NumericVector f2,
+             NumericVector f1,
+             int k = 5,
+             int restarts = 1,
+             int maxiter = 100,
+             double tol = 1e-8,
+             int kmiter = 10,
+             double floor = 1e-10,
+             double margin = R_PosInf,
+             int warmup = 5,
+             double seed = 1,
+             int threads = 0) {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  if(restarts < 1) {
+    Rcpp::stop("At least one restart is needed.");
+  }
+  if(!(margin >= 0)) {
+    Rcpp::stop("The early stopping margin must not be negative.");
+  }
+  std::size_t n = f2.size();
+  std::vector<std::size_t> keep;
+  for(std::size_t i = 0; i < n; ++i) {
+    if(!std::isnan(f2[i]) && !std::isnan(f1[i])) keep.push_back(i);
+  }
+  std::size_t m = keep.size();
+  if(k < 1 || (std::size_t) k > m) {
+    Rcpp::stop("The number of components must be between 1 and the number of complete frames.");
+  }
+  std::vector<double> x(m), y(m), ll(m);
+  for(std::size_t i = 0; i < m; ++i) {
+    x[i] = f2[keep[i]];
+    y[i] = f1[keep[i]];
+  }
+
+  threads = resolve_threads(threads);
+  std::vector<GMM2Restart> runs;
+  std::size_t best = gmm2_multistart(x.data(), y.data(), m, k, restarts,
+                                     maxiter, tol, kmiter, floor, margin,
+                                     warmup, (std::uint64_t) seed, threads,
+                                     runs);
+  if(runs[best].failed) {
+    Rcpp::stop("The mixture model could not be fitted: every restart gave a non-finite log-likelihood.");
+  }
+  const GMM2& model = runs[best].model;
+  gmm2_log_density(model, x.data(), y.data(), m, threads, ll.data());
+
+  NumericVector loglik(n, R_NaReal);
+  for(std::size_t i = 0; i < m; ++i) {
+    loglik[keep[i]] = ll[i];
+  }
+  NumericVector rll(restarts);
+  IntegerVector riter(restarts);
+  LogicalVector rconv(restarts), rstop(restarts), rfail(restarts);
+  for(int r = 0; r < restarts; ++r) {
+    rll[r] = runs[r].loglik;
+    riter[r] = runs[r].iterations;
+    rconv[r] = runs[r].converged;
+    rstop[r] = runs[r].stopped;
+    rfail[r] = runs[r].failed;
+  }
+  DataFrame summary = DataFrame::create(Named("Log_likelihood") = rll,
+                                        Named("iterations") = riter,
+                                        Named("converged") = rconv,
+                                        Named("stopped") = rstop,
+                                        Named("failed") = rfail);
+  return List::create(Named("weights") = model_weights(model),
+                      Named("centroids") = model_centroids(model),
+                      Named("covariances") = model_covariances(model),
+                      Named("Log_likelihood") = runs[best].loglik,
+                      Named("frame_log_likelihood") = loglik,
+                      Named("iterations") = runs[best].iterations,
+                      Named("converged") = runs[best].converged,
+                      Named("restart") = (int) best + 1,
+                      Named("restarts") = summary);
+}
+
+template <typename Source>
+static List online_cvsa(Source& src, int k, std::size_t chunk, int epochs,
+                        double decay, int kmiter, double floor,
+                        double threshold, double seed, int threads) {
+  threads = resolve_threads(threads);
+  Rng rng((std::uint64_t) seed, 0);
+  GMM2 model;
+  GMM2OnlineFit fit = gmm2_online_em(src, k, chunk, epochs, decay, kmiter,
+                                     floor, threads, rng, model);
+  if(fit.updates == 0) {
+    Rcpp::stop("The first chunk must contain at least as many complete frames as there are components.");
+  }
+  if(fit.failed) {
+    Rcpp::stop("The online mixture fit gave a non-finite log-likelihood.");
+  }
+  std::vector<double> hx, hy;
+  Hull h;
+  std::size_t kept = gmm2_stream_hull(src, model, threshold, chunk, threads,
+                                      hx, hy, h);
+  std::size_t nv = h.vertices.size();
+  NumericVector vf2(nv), vf1(nv);
+  for(std::size_t v = 0; v < nv; ++v) {
+    vf2[v] = hx[h.vertices[v]];
+    vf1[v] = hy[h.vertices[v]];
+  }
+  DataFrame hull = DataFrame::create(Named("F2") = vf2,
+                                     Named("F1") = vf1);
+  return List::create(Named("weights") = model_weights(model),
+                      Named("centroids") = model_centroids(model),
+                      Named("covariances") = model_covariances(model),
+                      Named("Log_likelihood") = fit.loglik,
+                      Named("frames") = (double) fit.frames,
+                      Named("updates") = (double) fit.updates,
+                      Named("kept") = (double) kept,
+                      Named("Hull") = hull);
+}
+
+// Native backend of cVSA.online(). Fits the mixture by online EM to frames
+// given either as vectors or in a binary file of (F2, F1) pairs, and returns
+// the model together with the vertices of the hull of the frames that pass
+// the likelihood filter, in counterclockwise order.
+// [[Rcpp::export]]
+List cppGMM2Online(NumericVector f2,
+                   NumericVector f1,
+                   std::string file = "",
+                   int k = 5,
+                   int chunk = 10000,
+                   int epochs = 1,
+                   double decay = 0.6,
+                   int kmiter = 10,
+                   double floor = 1e-10,
+                   double threshold = 0.3,
+                   double seed = 1,
+                   int threads = 0) {
+  if(k < 1) {
+    Rcpp::stop("At least one component is needed.");
+  }
+  if(chunk < 1 || epochs < 1) {
+    Rcpp::stop("The chunk size and the number of epochs must be positive.");
+  }
+  if(!(decay > 0.5 && decay <= 1)) {
+    Rcpp::stop("The decay must be in (0.5, 1].");
+  }
+  if(!file.empty()) {
+    FrameFile src(file);
+    if(!src.ok()) {
+      Rcpp::stop("Could not open the file " + file + ".");
+    }
+    return online_cvsa(src, k, chunk, epochs, decay, kmiter, floor,
+                       threshold, seed, threads);
+  }
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  FrameBuffer src(f2.begin(), f1.begin(), f2.size());
+  return online_cvsa(src, k, chunk, epochs, decay, kmiter, floor, threshold,
+                     seed, threads);
+}
+
+// Native backend of cVSA.sweep(). Applies the cVSA() likelihood filter for
+// every threshold to frames with cached log mixture densities. The frames
+// are sorted by density once, and since lowering the threshold only adds
+// frames, the hull is updated incrementally from the highest threshold to
+// the lowest. Returns the number of frames kept and the area and perimeter
+// of their hull, in the order of the thresholds.
+// [[Rcpp::export]]
+List cppCVSASweep(NumericVector f2,
+                  NumericVector f1,
+                  NumericVector loglik,
+                  NumericVector thresholds) {
+  if(f1.size() != f2.size() || loglik.size() != f2.size()) {
+    Rcpp::stop("The F1, F2 and log-likelihood vectors must be of the same length.");
+  }
+  std::vector<std::size_t> order;
+  for(int i = 0; i < f2.size(); ++i) {
+    if(!std::isnan(f2[i]) && !std::isnan(f1[i]) && !std::isnan(loglik[i])) {
+      order.push_back(i);
+    }
+  }
+  const double* ll = loglik.begin();
+  std::sort(order.begin(), order.end(), [ll](std::size_t a, std::size_t b) {
+    return ll[a] > ll[b];
+  });
+  double lmax = order.empty() ? 0 : ll[order[0]];
+
+  std::size_t nt = thresholds.size();
+  for(std::size_t t = 0; t < nt; ++t) {
+    if(std::isnan(thresholds[t])) {
+      Rcpp::stop("The thresholds must not be missing.");
+    }
+  }
+  std::vector<std::size_t> byThreshold(nt);
+  for(std::size_t t = 0; t < nt; ++t) {
+    byThreshold[t] = t;
+  }
+  std::sort(byThreshold.begin(), byThreshold.end(),
+            [&thresholds](std::size_t a, std::size_t b) {
+    return thresholds[a] > thresholds[b];
+  });
+  std::vector<std::size_t> prefix(nt);
+  std::size_t n = 0;
+  for(std::size_t c = 0; c < nt; ++c) {
+    double thr = thresholds[byThreshold[c]];
+    while(n < order.size() && std::exp(ll[order[n]] - lmax) >= thr) ++n;
+    prefix[c] = n;
+  }
+  std::vector<double> area(nt), perimeter(nt);
+  nested_hulls(f2.begin(), f1.begin(), order.data(), prefix.data(), nt,
+               area.data(), perimeter.data());
+
+  IntegerVector kept(nt);
+  NumericVector outArea(nt), outPerimeter(nt);
+  for(std::size_t c = 0; c < nt; ++c) {
+    std::size_t t = byThreshold[c];
+    kept[t] = prefix[c];
+    outArea[t] = area[c];
+    outPerimeter[t] = perimeter[c];
+  }
+  return List::create(Named("kept") = kept,
+                      Named("area") = outArea,
+                      Named("perimeter") = outPerimeter);
+}
@@ -0,0 +1,515 @@
+#ifndef ARTICULATED_GMM2_H
+#define ARTICULATED_GMM2_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "bootstrap.h"
+#include "matrix2.h"
+#include "parallel.h"
+#include "vowelspace.h"
+
+// Gaussian mixture models of points in the plane with full 2 x 2
+// covariance matrices, fitted by expectation maximisation (EM).
+//
+// Components are stored as a structure of arrays, and all matrix algebra
+// is done in closed form. The E-step walks the points in blocks: for every
+// component the log densities of a whole block are computed in one
+// branch-free loop that the compiler can vectorise, after which the
+// responsibilities and the sufficient statistics of the block follow in
+// equally simple loops. Blocks are processed in parallel, the statistics of
+// every block are kept apart, and they are summed in block order, so that
+// the result does not depend on the number of threads.
+
+namespace articulated {
+
+const double LOG_2PI = 1.8378770664093453;
+
+class GMM2 {
+public:
+  int k;
+  std::vector<double> weight;
+  std::vector<double> mx, my;
+  // Covariance matrices [sxx sxy; sxy syy]
+  std::vector<double> sxx, sxy, syy;
+
+  explicit GMM2(int k = 0)
+    : k(k), weight(k), mx(k), my(k), sxx(k), sxy(k), syy(k),
+      ixx(k), ixy(k), iyy(k), lnorm(k) {}
+
+  // Updates the inverse covariances and the log normalising constants,
+  // log(weight) - log(2 pi) - log(det) / 2, after the parameters changed.
+  void prepare() {
+    for(int j = 0; j < k; ++j) {
+      Sym2 s = {sxx[j], sxy[j], syy[j]};
+      Sym2 inv = s.inverse();
+      ixx[j] = inv.a;
+      ixy[j] = inv.b;
+      iyy[j] = inv.c;
+      lnorm[j] = std::log(weight[j]) - LOG_2PI - 0.5 * std::log(s.det());
+    }
+  }
+
+  // Writes log(weight_j N(x_i | mu_j, S_j)) of component j for n points to
+  // out.
+  void log_component(int j, const double* x, const double* y, std::size_t n,
+                     double* out) const {
+    double cx = mx[j], cy = my[j], a = ixx[j], b = ixy[j], c = iyy[j];
+    double ln = lnorm[j];
+#pragma omp simd
+    for(std::size_t i = 0; i < n; ++i) {
+      double dx = x[i] - cx;
+      double dy = y[i] - cy;
+      out[i] = ln - 0.5 * (a * dx * dx + 2 * b * dx * dy + c * dy * dy);
+    }
+  }
+
+private:
+  std::vector<double> ixx, ixy, iyy, lnorm;
+};
+
+// The sufficient statistics of the M-step: for every component the sums of
+// the responsibilities r, and of r x, r y, r x^2, r x y and r y^2.
+struct GMM2Stats {
+  std::vector<double> r, rx, ry, rxx, rxy, ryy;
+  double loglik;
+
+  explicit GMM2Stats(int k = 0)
+    : r(k, 0.0), rx(k, 0.0), ry(k, 0.0), rxx(k, 0.0), rxy(k, 0.0),
+      ryy(k, 0.0), loglik(0) {}
+
+  // The number of values written by store()
+  static std::size_t packed_size(int k) {
+    return 6 * (std::size_t) k + 1;
+  }
+
+  void clear() {
+    std::size_t k = r.size();
+    r.assign(k, 0.0);
+    rx.assign(k, 0.0);
+    ry.assign(k, 0.0);
+    rxx.assign(k, 0.0);
+    rxy.assign(k, 0.0);
+    ryy.assign(k, 0.0);
+    loglik = 0;
+  }
+
+  // Packs the statistics into packed_size(k) values at out.
+  void store(double* out) const {
+    std::size_t k = r.size();
+    std::copy(r.begin(), r.end(), out);
+    std::copy(rx.begin(), rx.end(), out + k);
+    std::copy(ry.begin(), ry.end(), out + 2 * k);
+    std::copy(rxx.begin(), rxx.end(), out + 3 * k);
+    std::copy(rxy.begin(), rxy.end(), out + 4 * k);
+    std::copy(ryy.begin(), ryy.end(), out + 5 * k);
+    out[6 * k] = loglik;
+  }
+
+  // Adds statistics packed by store().
+  void merge(const double* in) {
+    std::size_t k = r.size();
+    for(std::size_t j = 0; j < k; ++j) {
+      r[j] += in[j];
+      rx[j] += in[k + j];
+      ry[j] += in[2 * k + j];
+      rxx[j] += in[3 * k + j];
+      rxy[j] += in[4 * k + j];
+      ryy[j] += in[5 * k + j];
+    }
+    loglik += in[6 * k];
+  }
+};
+
+const std::size_t GMM2_BLOCK = 256;
+
+// Evaluates the mixture for one block of n <= GMM2_BLOCK points. 'work'
+// must hold (k + 2) * GMM2_BLOCK values. Afterwards the first k rows of
+// work hold weight_j N(x_i | mu_j, S_j) scaled by exp(-lmax_i), where lmax
+// is the following row, and the row after that holds their sum over the
+// components. The log mixture density of point i is lmax_i + log(sum_i).
+inline void gmm2_mixture_block(const GMM2& model, const double* x,
+                               const double* y, std::size_t n, double* work) {
+  int k = model.k;
+  double* lmax = work + (std::size_t) k * GMM2_BLOCK;
+  double* lsum = lmax + GMM2_BLOCK;
+  for(int j = 0; j < k; ++j) {
+    model.log_component(j, x, y, n, work + (std::size_t) j * GMM2_BLOCK);
+  }
+  // Log-sum-exp over the components
+  std::fill(lmax, lmax + n, -std::numeric_limits<double>::infinity());
+  for(int j = 0; j < k; ++j) {
+    const double* l = work + (std::size_t) j * GMM2_BLOCK;
+    for(std::size_t i = 0; i < n; ++i) {
+      lmax[i] = std::max(lmax[i], l[i]);
+    }
+  }
+  std::fill(lsum, lsum + n, 0.0);
+  for(int j = 0; j < k; ++j) {
+    double* l = work + (std::size_t) j * GMM2_BLOCK;
+    for(std::size_t i = 0; i < n; ++i) {
+      l[i] = std::exp(l[i] - lmax[i]);
+      lsum[i] += l[i];
+    }
+  }
+}
+
+// The E-step for one block of n <= GMM2_BLOCK points. Accumulates the
+// sufficient statistics and the log-likelihood into st. 'work' is as for
+// gmm2_mixture_block().
+inline void gmm2_estep_block(const GMM2& model, const double* x,
+                             const double* y, std::size_t n, double* work,
+                             GMM2Stats& st) {
+  int k = model.k;
+  double* lmax = work + (std::size_t) k * GMM2_BLOCK;
+  double* lsum = lmax + GMM2_BLOCK;
+  gmm2_mixture_block(model, x, y, n, work);
+  for(std::size_t i = 0; i < n; ++i) {
+    st.loglik += lmax[i] + std::log(lsum[i]);
+    lsum[i] = 1 / lsum[i];
+  }
+  // Responsibilities and sufficient statistics
+  for(int j = 0; j < k; ++j) {
+    const double* l = work + (std::size_t) j * GMM2_BLOCK;
+    double r = 0, rx = 0, ry = 0, rxx = 0, rxy = 0, ryy = 0;
+#pragma omp simd reduction(+:r,rx,ry,rxx,rxy,ryy)
+    for(std::size_t i = 0; i < n; ++i) {
+      double ri = l[i] * lsum[i];
+      r += ri;
+      rx += ri * x[i];
+      ry += ri * y[i];
+      rxx += ri * x[i] * x[i];
+      rxy += ri * x[i] * y[i];
+      ryy += ri * y[i] * y[i];
+    }
+    st.r[j] += r;
+    st.rx[j] += rx;
+    st.ry[j] += ry;
+    st.rxx[j] += rxx;
+    st.rxy[j] += rxy;
+    st.ryy[j] += ryy;
+  }
+}
+
+// A full E-step over n points, in parallel over blocks. The statistics of
+// each block are packed into their own row and summed in block order, so
+// the floating point result is the same for any number of threads.
+inline void gmm2_estep(const GMM2& model, const double* x, const double* y,
+                       std::size_t n, int threads, GMM2Stats& total) {
+  int k = model.k;
+  long nblocks = (long) ((n + GMM2_BLOCK - 1) / GMM2_BLOCK);
+  std::size_t stride = GMM2Stats::packed_size(k);
+  std::vector<double> partial(nblocks * stride);
+#pragma omp parallel num_threads(threads)
+{
+  std::vector<double> work((std::size_t) (k + 2) * GMM2_BLOCK);
+  GMM2Stats st(k);
+#pragma omp for schedule(static)
+  for(long b = 0; b < nblocks; ++b) {
+    std::size_t from = (std::size_t) b * GMM2_BLOCK;
+    std::size_t m = std::min(GMM2_BLOCK, n - from);
+    st.clear();
+    gmm2_estep_block(model, x + from, y + from, m, work.data(), st);
+    st.store(partial.data() + b * stride);
+  }
+}
+  total = GMM2Stats(k);
+  for(long b = 0; b < nblocks; ++b) {
+    total.merge(partial.data() + b * stride);
+  }
+}
+
+// The log mixture density of n points under a model, in parallel over
+// blocks. Points with a missing coordinate get a missing density.
+inline void gmm2_log_density(const GMM2& model, const double* x,
+                             const double* y, std::size_t n, int threads,
+                             double* out) {
+  int k = model.k;
+  long nblocks = (long) ((n + GMM2_BLOCK - 1) / GMM2_BLOCK);
+#pragma omp parallel num_threads(threads)
+{
+  std::vector<double> work((std::size_t) (k + 2) * GMM2_BLOCK);
+  const double* lmax = work.data() + (std::size_t) k * GMM2_BLOCK;
+  const double* lsum = lmax + GMM2_BLOCK;
+#pragma omp for schedule(static)
+  for(long b = 0; b < nblocks; ++b) {
+    std::size_t from = (std::size_t) b * GMM2_BLOCK;
+    std::size_t m = std::min(GMM2_BLOCK, n - from);
+    gmm2_mixture_block(model, x + from, y + from, m, work.data());
+    for(std::size_t i = 0; i < m; ++i) {
+      bool missing = std::isnan(x[from + i]) || std::isnan(y[from + i]);
+      out[from + i] = missing ? na_real() : lmax[i] + std::log(lsum[i]);
+    }
+  }
+}
+}
+
+// Sets the covariance of component j. Variances are floored at 'floor' so
+// that a component that collapses onto a few identical points keeps a
+// usable covariance, and the covariance is clamped so that the matrix stays
+// positive definite also for collinear points.
+inline void gmm2_set_covariance(GMM2& model, int j, double sxx, double sxy,
+                                double syy, double floor) {
+  model.sxx[j] = std::max(sxx, floor);
+  model.syy[j] = std::max(syy, floor);
+  double lim = 0.999999 * std::sqrt(model.sxx[j] * model.syy[j]);
+  model.sxy[j] = std::max(-lim, std::min(lim, sxy));
+}
+
+// The M-step (see gmm2_set_covariance() for the covariances). A component
+// without any responsibility keeps its previous parameters.
+inline void gmm2_mstep(const GMM2Stats& st, double n, double floor,
+                       GMM2& model) {
+  for(int j = 0; j < model.k; ++j) {
+    double r = st.r[j];
+    if(!(r > 0)) continue;
+    double mx = st.rx[j] / r;
+    double my = st.ry[j] / r;
+    model.weight[j] = r / n;
+    model.mx[j] = mx;
+    model.my[j] = my;
+    gmm2_set_covariance(model, j, st.rxx[j] / r - mx * mx,
+                        st.rxy[j] / r - mx * my, st.ryy[j] / r - my * my,
+                        floor);
+  }
+  model.prepare();
+}
+
+// Clusters the points by k-means (Lloyd), starting from the centers
+// (cx[j], cy[j]), and initialises a model from the clusters: each component
+// gets the mean, the covariance and the share of the points of its
+// cluster, made positive definite as in the M-step, so that a cluster of
+// two (or collinear) points does not start out singular. Components whose
+// cluster is empty start from the overall spread of the points.
+inline void gmm2_kmeans(const double* x, const double* y, std::size_t n,
+                        int k, int iterations, double floor,
+                        std::vector<double>& cx, std::vector<double>& cy,
+                        GMM2& model) {
+  model = GMM2(k);
+  std::vector<int> label(n, 0);
+  for(int it = 0; it <= iterations; ++it) {
+    for(std::size_t i = 0; i < n; ++i) {
+      double best = std::numeric_limits<double>::infinity();
+      for(int j = 0; j < k; ++j) {
+        double dx = x[i] - cx[j], dy = y[i] - cy[j];
+        double d = dx * dx + dy * dy;
+        if(d < best) {
+          best = d;
+          label[i] = j;
+        }
+      }
+    }
+    std::vector<Moments2> mom(k);
+    for(std::size_t i = 0; i < n; ++i) {
+      mom[label[i]].add(x[i], y[i]);
+    }
+    for(int j = 0; j < k; ++j) {
+      if(mom[j].n == 0) continue;
+      cx[j] = mom[j].mx;
+      cy[j] = mom[j].my;
+      if(it == iterations) {
+        model.weight[j] = (double) mom[j].n / n;
+        model.mx[j] = mom[j].mx;
+        model.my[j] = mom[j].my;
+        gmm2_set_covariance(model, j, mom[j].sxx / mom[j].n,
+                            mom[j].sxy / mom[j].n, mom[j].syy / mom[j].n,
+                            floor);
+      }
+    }
+  }
+  Moments2 all;
+  for(std::size_t i = 0; i < n; ++i) {
+    all.add(x[i], y[i]);
+  }
+  for(int j = 0; j < k; ++j) {
+    if(model.weight[j] > 0) continue;
+    model.weight[j] = 1.0 / n;
+    model.mx[j] = cx[j];
+    model.my[j] = cy[j];
+    gmm2_set_covariance(model, j, all.sxx / n, 0, all.syy / n, floor);
+  }
+  model.prepare();
+}
+
+// Initialises a model by k-means, seeded with k points drawn at random
+// without replacement.
+inline void gmm2_init_kmeans(const double* x, const double* y, std::size_t n,
+                             int k, int iterations, double floor, Rng& rng,
+                             GMM2& model) {
+  std::vector<double> cx(k), cy(k);
+  // A partial Fisher-Yates shuffle of the point indices
+  std::vector<std::size_t> pick(n);
+  for(std::size_t i = 0; i < n; ++i) {
+    pick[i] = i;
+  }
+  for(int j = 0; j < k; ++j) {
+    std::size_t i = j + rng.below(n - j);
+    std::swap(pick[j], pick[i]);
+    cx[j] = x[pick[j]];
+    cy[j] = y[pick[j]];
+  }
+  gmm2_kmeans(x, y, n, k, iterations, floor, cx, cy, model);
+}
+
+// Initialises a model by k-means, seeded by k-means++ (Arthur and
+// Vassilvitskii, 2007): the first center is a point drawn at random, and
+// every following center is a point drawn with probability proportional
+// to its squared distance to the nearest center chosen so far.
+inline void gmm2_init_kmeanspp(const double* x, const double* y,
+                               std::size_t n, int k, int iterations,
+                               double floor, Rng& rng, GMM2& model) {
+  std::vector<double> cx(k), cy(k);
+  std::vector<double> d2(n, std::numeric_limits<double>::infinity());
+  std::size_t pick = rng.below(n);
+  for(int j = 0; j < k; ++j) {
+    cx[j] = x[pick];
+    cy[j] = y[pick];
+    if(j == k - 1) break;
+    double total = 0;
+    for(std::size_t i = 0; i < n; ++i) {
+      double dx = x[i] - cx[j], dy = y[i] - cy[j];
+      d2[i] = std::min(d2[i], dx * dx + dy * dy);
+      total += d2[i];
+    }
+    if(!(total > 0)) {
+      // All points coincide with a center
+      pick = rng.below(n);
+      continue;
+    }
+    double u = rng.uniform() * total;
+    pick = n - 1;
+    for(std::size_t i = 0; i < n; ++i) {
+      u -= d2[i];
+      if(u < 0) {
+        pick = i;
+        break;
+      }
+    }
+  }
+  gmm2_kmeans(x, y, n, k, iterations, floor, cx, cy, model);
+}
+
+// One EM iteration: an E-step under the current model followed by an
+// M-step. Returns the mean log-likelihood of the points under the model
+// before the update.
+inline double gmm2_em_iteration(const double* x, const double* y,
+                                std::size_t n, double floor, int threads,
+                                GMM2Stats& st, GMM2& model) {
+  gmm2_estep(model, x, y, n, threads, st);
+  gmm2_mstep(st, n, floor, model);
+  return st.loglik / n;
+}
+
+// One restart of a multi-start fit.
+struct GMM2Restart {
+  GMM2 model;
+  GMM2Stats st;
+  double previous, current;
+  int iterations;
+  bool converged;
+  // Stopped early, as clearly losing
+  bool stopped;
+  // Abandoned after a non-finite log-likelihood
+  bool failed;
+  // The total log-likelihood under the final model
+  double loglik;
+};
+
+// Fits a k component mixture to n points from several starting points and
+// returns the index of the restart with the largest log-likelihood.
+//
+// Restart r is seeded by k-means++ from its own random stream, Rng(seed, r),
+// and all restarts read the same points. The restarts advance in lockstep,
+// one EM iteration per round. When there are at least as many restarts as
+// threads, the restarts of a round run concurrently, one per thread;
+// otherwise they run one at a time with a parallel E-step. After each round
+// a restart is stopped early if it has done at least 'warmup' iterations
+// and its mean log-likelihood is more than 'margin' below the best mean
+// log-likelihood of any restart. A restart whose log-likelihood becomes
+// non-finite is abandoned as failed and never chosen; if every restart
+// fails, the returned restart is marked as failed. Since the rounds are
+// synchronous and every E-step sums its blocks in a fixed order (see
+// gmm2_estep()), the result does not depend on the number of threads or on
+// scheduling.
+inline std::size_t gmm2_multistart(const double* x, const double* y,
+                                   std::size_t n, int k, int restarts,
+                                   int maxiter, double tol, int kmiter,
+                                   double floor, double margin, int warmup,
+                                   std::uint64_t seed, int threads,
+                                   std::vector<GMM2Restart>& runs) {
+  runs.assign(restarts, GMM2Restart());
+  bool concurrent = restarts >= threads;
+  int inner = concurrent ? 1 : threads;
+
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+  for(int r = 0; r < restarts; ++r) {
+    GMM2Restart& run = runs[r];
+    Rng rng(seed, r);
+    gmm2_init_kmeanspp(x, y, n, k, kmiter, floor, rng, run.model);
+    run.st = GMM2Stats(k);
+    run.previous = -std::numeric_limits<double>::infinity();
+    run.current = run.previous;
+    run.iterations = 0;
+    run.converged = false;
+    run.stopped = false;
+    run.failed = false;
+  }
+
+  std::vector<int> active;
+  for(int it = 0; it < maxiter; ++it) {
+    active.clear();
+    for(int r = 0; r < restarts; ++r) {
+      const GMM2Restart& run = runs[r];
+      if(!run.converged && !run.stopped && !run.failed) active.push_back(r);
+    }
+    if(active.empty()) break;
+    int na = (int) active.size();
+#pragma omp parallel for num_threads(threads) schedule(dynamic) if(concurrent)
+    for(int a = 0; a < na; ++a) {
+      GMM2Restart& run = runs[active[a]];
+      run.previous = run.current;
+      run.current = gmm2_em_iteration(x, y, n, floor, inner, run.st,
+                                      run.model);
+      run.iterations = it + 1;
+      run.failed = !std::isfinite(run.current);
+      run.converged = !run.failed && std::fabs(run.current - run.previous) < tol;
+    }
+    double best = -std::numeric_limits<double>::infinity();
+    for(int r = 0; r < restarts; ++r) {
+      if(!runs[r].failed) best = std::max(best, runs[r].current);
+    }
+    for(int a = 0; a < na; ++a) {
+      GMM2Restart& run = runs[active[a]];
+      if(!run.converged && !run.failed && run.iterations >= warmup &&
+         run.current < best - margin) {
+        run.stopped = true;
+      }
+    }
+  }
+
+  // The log-likelihood under the final models
+#pragma omp parallel for num_threads(threads) schedule(dynamic) if(concurrent)
+  for(int r = 0; r < restarts; ++r) {
+    GMM2Restart& run = runs[r];
+    run.loglik = na_real();
+    if(run.stopped || run.failed) continue;
+    gmm2_estep(run.model, x, y, n, inner, run.st);
+    run.failed = !std::isfinite(run.st.loglik);
+    if(!run.failed) run.loglik = run.st.loglik;
+  }
+  std::size_t out = 0;
+  for(int r = 1; r < restarts; ++r) {
+    bool usable = !runs[r].stopped && !runs[r].failed;
+    if(usable && (runs[out].stopped || runs[out].failed ||
+                  runs[r].loglik > runs[out].loglik)) out = r;
+  }
+  return out;
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef ARTICULATED_GMM2_ONLINE_H
+#define ARTICULATED_GMM2_ONLINE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "bootstrap.h"
+#include "gmm2.h"
+#include "hull.h"
+#include "vowelspace.h"
+
+// Online (minibatch) EM for the 2-D Gaussian mixtures of gmm2.h, for formant
+// tracks that are too long to fit by batch EM or to hold in memory.
+//
+// Frames are read from a source in chunks. A source has two members:
+//
+//   std::size_t read(double* f2, double* f1, std::size_t max)
+//     reads up to max frames, returning the number read (0 at the end);
+//   void rewind()
+//     starts over from the first frame.
+//
+// Only one chunk is held in memory at a time, so memory use does not depend
+// on the length of the track.
+
+namespace articulated {
+
+// Frames held in memory by the caller.
+class FrameBuffer {
+public:
+  FrameBuffer(const double* f2, const double* f1, std::size_t n)
+    : f2(f2), f1(f1), n(n), pos(0) {}
+
+  std::size_t read(double* x, double* y, std::size_t max) {
+    std::size_t m = std::min(max, n - pos);
+    std::copy(f2 + pos, f2 + pos + m, x);
+    std::copy(f1 + pos, f1 + pos + m, y);
+    pos += m;
+    return m;
+  }
+
+  void rewind() {
+    pos = 0;
+  }
+
+private:
+  const double* f2;
+  const double* f1;
+  std::size_t n, pos;
+};
+
+// Frames stored in a binary file as pairs of doubles (F2, F1) in native
+// byte order, as written by writeBin(as.vector(rbind(F2, F1)), file).
+// A trailing incomplete frame is ignored.
+class FrameFile {
+public:
+  explicit FrameFile(const std::string& path)
+    : file(std::fopen(path.c_str(), "rb")) {}
+
+  ~FrameFile() {
+    if(file) std::fclose(file);
+  }
+
+  bool ok() const {
+    return file != 0;
+  }
+
+  std::size_t read(double* x, double* y, std::size_t max) {
+    buffer.resize(2 * max);
+    std::size_t m = std::fread(buffer.data(), 2 * sizeof(double), max, file);
+    for(std::size_t i = 0; i < m; ++i) {
+      x[i] = buffer[2 * i];
+      y[i] = buffer[2 * i + 1];
+    }
+    return m;
+  }
+
+  void rewind() {
+    std::rewind(file);
+  }
+
+private:
+  std::FILE* file;
+  std::vector<double> buffer;
+
+  FrameFile(const FrameFile&);
+  FrameFile& operator=(const FrameFile&);
+};
+
+// Reads the next chunk from a source and drops the frames with a missing
+// formant. Returns the number of complete frames, and sets 'read' to the
+// number of frames read, which is 0 at the end of the source.
+template <typename Source>
+std::size_t read_complete(Source& src, double* x, double* y, std::size_t max,
+                          std::size_t& read) {
+  read = src.read(x, y, max);
+  std::size_t m = 0;
+  for(std::size_t i = 0; i < read; ++i) {
+    if(std::isnan(x[i]) || std::isnan(y[i])) continue;
+    x[m] = x[i];
+    y[m] = y[i];
+    ++m;
+  }
+  return m;
+}
+
+// Blends the per-frame sufficient statistics of a chunk into running ones:
+// s = (1 - rho) s + rho o.
+inline void gmm2_blend(GMM2Stats& s, const GMM2Stats& o, double rho) {
+  for(std::size_t j = 0; j < s.r.size(); ++j) {
+    s.r[j] += rho * (o.r[j] - s.r[j]);
+    s.rx[j] += rho * (o.rx[j] - s.rx[j]);
+    s.ry[j] += rho * (o.ry[j] - s.ry[j]);
+    s.rxx[j] += rho * (o.rxx[j] - s.rxx[j]);
+    s.rxy[j] += rho * (o.rxy[j] - s.rxy[j]);
+    s.ryy[j] += rho * (o.ryy[j] - s.ryy[j]);
+  }
+}
+
+struct GMM2OnlineFit {
+  // The number of chunk updates made
+  std::size_t updates;
+  // The number of complete frames in the source
+  std::size_t frames;
+  // The log-likelihood of the frames during the last epoch, each chunk
+  // evaluated under the model before it was used for an update
+  double loglik;
+  // Whether a chunk got a non-finite log-likelihood, after which the fit
+  // was abandoned
+  bool failed;
+};
+
+// Fits a k component mixture by online EM (Cappe and Moulines, 2009).
+//
+// The model is initialised by k-means on the complete frames of the first
+// chunk. Each following chunk gets an E-step under the current model, and
+// its per-frame sufficient statistics are blended into the running ones
+// with the step size rho_t = (t + 1)^-decay, t = 1, 2, ...; the M-step then
+// recomputes the model from the running statistics. 'decay' should be in
+// (0.5, 1]. The source is read 'epochs' times. Returns with updates = 0 if
+// the first chunk has fewer than k complete frames, and with 'failed' set as
+// soon as the E-step of a chunk gives a non-finite log-likelihood, before
+// the model is updated from it.
+template <typename Source>
+GMM2OnlineFit gmm2_online_em(Source& src, int k, std::size_t chunk,
+                             int epochs, double decay, int kmiter,
+                             double floor, int threads, Rng& rng,
+                             GMM2& model) {
+  GMM2OnlineFit fit = {0, 0, na_real(), false};
+  std::vector<double> x(chunk), y(chunk);
+  std::size_t read;
+  std::size_t m = read_complete(src, x.data(), y.data(), chunk, read);
+  if(m < (std::size_t) k || k < 1) return fit;
+  gmm2_init_kmeans(x.data(), y.data(), m, k, kmiter, floor, rng, model);
+
+  GMM2Stats running(k), st(k);
+  for(int e = 0; e < epochs; ++e) {
+    src.rewind();
+    fit.frames = 0;
+    fit.loglik = 0;
+    for(;;) {
+      m = read_complete(src, x.data(), y.data(), chunk, read);
+      if(read == 0) break;
+      if(m == 0) continue;
+      gmm2_estep(model, x.data(), y.data(), m, threads, st);
+      if(!std::isfinite(st.loglik)) {
+        fit.failed = true;
+        return fit;
+      }
+      fit.frames += m;
+      fit.loglik += st.loglik;
+      double rho = fit.updates == 0 ? 1 : std::pow(fit.updates + 1.0, -decay);
+      for(int j = 0; j < k; ++j) {
+        st.r[j] /= m;
+        st.rx[j] /= m;
+        st.ry[j] /= m;
+        st.rxx[j] /= m;
+        st.rxy[j] /= m;
+        st.ryy[j] /= m;
+      }
+      gmm2_blend(running, st, rho);
+      gmm2_mstep(running, 1, floor, model);
+      ++fit.updates;
+    }
+  }
+  return fit;
+}
+
+// Applies the cVSA() likelihood filter to the frames of a source and
+// computes the convex hull of the frames that pass, streaming over the
+// source twice: first for the largest log mixture density of a frame, then
+// to keep every frame whose density is at least 'threshold' times that
+// largest density. Only the vertices of the hull of the frames kept so far
+// are held between chunks. hx and hy receive the coordinates of the hull
+// vertices, which the vertices of the hull index. Returns the number of
+// frames that passed the filter.
+template <typename Source>
+std::size_t gmm2_stream_hull(Source& src, const GMM2& model, double threshold,
+                             std::size_t chunk, int threads,
+                             std::vector<double>& hx, std::vector<double>& hy,
+                             Hull& hull) {
+  std::vector<double> x(chunk), y(chunk), ll(chunk);
+  std::size_t read, m;
+
+  double lmax = -std::numeric_limits<double>::infinity();
+  src.rewind();
+  while((m = read_complete(src, x.data(), y.data(), chunk, read), read > 0)) {
+    gmm2_log_density(model, x.data(), y.data(), m, threads, ll.data());
+    for(std::size_t i = 0; i < m; ++i) {
+      lmax = std::max(lmax, ll[i]);
+    }
+  }
+
+  std::size_t kept = 0;
+  std::vector<std::size_t> order;
+  hx.clear();
+  hy.clear();
+  src.rewind();
+  while((m = read_complete(src, x.data(), y.data(), chunk, read), read > 0)) {
+    gmm2_log_density(model, x.data(), y.data(), m, threads, ll.data());
+    for(std::size_t i = 0; i < m; ++i) {
+      if(std::exp(ll[i] - lmax) >= threshold) {
+        hx.push_back(x[i]);
+        hy.push_back(y[i]);
+        ++kept;
+      }
+    }
+    // Reduce the kept frames to the vertices of their hull
+    reduce_to_hull(hx, hy, order, hull);
+  }
+  return kept;
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,27 @@
+#include <Rcpp.h>
+#include "hull.h"
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// Native convex hull used by VSD() and cVSA(). Returns the 1-based indices
+// of the hull vertices in counterclockwise order, and the area and
+// perimeter of the hull.
+// [[Rcpp::export]]
+List cppConvexHull(NumericVector x,
+                   NumericVector y) {
+  if(x.size() != y.size()) {
+    Rcpp::stop("The x and y vectors must be of the same length.");
+  }
+  std::vector<std::size_t> order;
+  Hull h;
+  convex_hull(x.begin(), y.begin(), x.size(), order, h);
+  IntegerVector vertices(h.vertices.size());
+  for(std::size_t i = 0; i < h.vertices.size(); ++i) {
+    vertices[i] = h.vertices[i] + 1;
+  }
+  return List::create(Named("vertices") = vertices,
+                      Named("area") = h.area,
+                      Named("perimeter") = h.perimeter);
+}
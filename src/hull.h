@@ -0,0 +1,129 @@
+#ifndef ARTICULATED_HULL_H
+#define ARTICULATED_HULL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Convex hulls of points in the plane, by Andrew's monotone chain algorithm.
+
+namespace articulated {
+
+struct Hull {
+  // Indices of the hull vertices, counterclockwise. Points on the edges of
+  // the hull are not vertices.
+  std::vector<std::size_t> vertices;
+  double area;
+  double perimeter;
+};
+
+// The cross product of (a - o) and (b - o); positive for a counterclockwise
+// turn o -> a -> b.
+inline double cross(double ox, double oy, double ax, double ay, double bx,
+                    double by) {
+  return (ax - ox) * (by - oy) - (ay - oy) * (bx - ox);
+}
+
+// Computes the convex hull of the points (x[i], y[i]). Points with a missing
+// coordinate are ignored. 'order' is scratch space that is reused between
+// calls. The hull of fewer than three distinct points, or of collinear
+// points, has no area; its vertices are then the extreme points.
+inline void convex_hull(const double* x, const double* y, std::size_t n,
+                        std::vector<std::size_t>& order, Hull& out) {
+  order.clear();
+  for(std::size_t i = 0; i < n; ++i) {
+    if(!std::isnan(x[i]) && !std::isnan(y[i])) order.push_back(i);
+  }
+  std::sort(order.begin(), order.end(), [x, y](std::size_t a, std::size_t b) {
+    return x[a] < x[b] || (x[a] == x[b] && y[a] < y[b]);
+  });
+  order.erase(std::unique(order.begin(), order.end(),
+                          [x, y](std::size_t a, std::size_t b) {
+    return x[a] == x[b] && y[a] == y[b];
+  }), order.end());
+
+  std::vector<std::size_t>& h = out.vertices;
+  std::size_t m = order.size();
+  h.assign(m < 3 ? m : 2 * m, 0);
+  std::size_t k = 0;
+  if(m < 3) {
+    for(std::size_t i = 0; i < m; ++i) {
+      h[k++] = order[i];
+    }
+  } else {
+    // Lower hull, then upper hull, dropping non-left turns
+    for(std::size_t i = 0; i < m; ++i) {
+      std::size_t p = order[i];
+      while(k >= 2 && cross(x[h[k - 2]], y[h[k - 2]], x[h[k - 1]], y[h[k - 1]],
+                            x[p], y[p]) <= 0) --k;
+      h[k++] = p;
+    }
+    for(std::size_t i = m - 1, lower = k + 1; i-- > 0;) {
+      std::size_t p = order[i];
+      while(k >= lower && cross(x[h[k - 2]], y[h[k - 2]], x[h[k - 1]],
+                                y[h[k - 1]], x[p], y[p]) <= 0) --k;
+      h[k++] = p;
+    }
+    // The last vertex repeats the first
+    --k;
+  }
+  h.resize(k);
+
+  out.area = 0;
+  out.perimeter = 0;
+  for(std::size_t i = 0; i < k; ++i) {
+    std::size_t a = h[i], b = h[(i + 1) % k];
+    out.area += x[a] * y[b] - x[b] * y[a];
+    out.perimeter += std::hypot(x[b] - x[a], y[b] - y[a]);
+  }
+  out.area = std::fabs(out.area) / 2;
+}
+
+// Computes the hull of the points (x[i], y[i]) and then drops all points
+// but the hull vertices, which are kept in hull order. The vertices of the
+// hull are renumbered to index the remaining points.
+inline void reduce_to_hull(std::vector<double>& x, std::vector<double>& y,
+                           std::vector<std::size_t>& order, Hull& out) {
+  convex_hull(x.data(), y.data(), x.size(), order, out);
+  std::size_t nv = out.vertices.size();
+  std::vector<double> vx(nv), vy(nv);
+  for(std::size_t v = 0; v < nv; ++v) {
+    vx[v] = x[out.vertices[v]];
+    vy[v] = y[out.vertices[v]];
+    out.vertices[v] = v;
+  }
+  x.swap(vx);
+  y.swap(vy);
+}
+
+// Computes the hulls of nested sets of points: the points order[0],
+// order[1], ... are added in turn, and the area and perimeter of the hull of
+// the first prefix[c] points are stored for every c. prefix must be
+// non-decreasing. The hull is updated incrementally, since the hull of a
+// set plus some new points is the hull of its vertices and the new points.
+inline void nested_hulls(const double* x, const double* y,
+                         const std::size_t* order, const std::size_t* prefix,
+                         std::size_t ncuts, double* area, double* perimeter) {
+  std::vector<double> hx, hy;
+  std::vector<std::size_t> scratch;
+  Hull h;
+  h.area = 0;
+  h.perimeter = 0;
+  std::size_t next = 0;
+  for(std::size_t c = 0; c < ncuts; ++c) {
+    if(prefix[c] > next) {
+      for(; next < prefix[c]; ++next) {
+        hx.push_back(x[order[next]]);
+        hy.push_back(y[order[next]]);
+      }
+      reduce_to_hull(hx, hy, scratch, h);
+    }
+    area[c] = h.area;
+    perimeter[c] = h.perimeter;
+  }
+}
+
+} // namespace articulated
+
+#endif
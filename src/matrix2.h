@@ -0,0 +1,78 @@
+#ifndef ARTICULATED_MATRIX2_H
+#define ARTICULATED_MATRIX2_H
+
+#include <cmath>
+#include <cstddef>
+
+// Closed form 2 x 2 symmetric matrix algebra and running co-moments for
+// points in the F2/F1 (or any other) plane.
+
+namespace articulated {
+
+// The symmetric matrix [a b; b c]
+struct Sym2 {
+  double a, b, c;
+
+  double det() const {
+    return a * c - b * b;
+  }
+
+  // The inverse. The result is not finite for singular matrices.
+  Sym2 inverse() const {
+    double d = det();
+    Sym2 out = {c / d, -b / d, a / d};
+    return out;
+  }
+
+  // x' M x
+  double quad(double x, double y) const {
+    return a * x * x + 2 * b * x * y + c * y * y;
+  }
+
+  Sym2 operator+(const Sym2& o) const {
+    Sym2 out = {a + o.a, b + o.b, c + o.c};
+    return out;
+  }
+
+  Sym2 operator*(double k) const {
+    Sym2 out = {a * k, b * k, c * k};
+    return out;
+  }
+};
+
+// Running means and co-moments (Welford) of points (x,y). Points with a
+// missing coordinate are skipped.
+struct Moments2 {
+  std::size_t n;
+  double mx, my;
+  double sxx, sxy, syy;
+
+  Moments2() : n(0), mx(0), my(0), sxx(0), sxy(0), syy(0) {}
+
+  void add(double x, double y) {
+    if(std::isnan(x) || std::isnan(y)) return;
+    ++n;
+    double dx = x - mx;
+    double dy = y - my;
+    mx += dx / n;
+    my += dy / n;
+    sxx += dx * (x - mx);
+    syy += dy * (y - my);
+    sxy += dx * (y - my);
+  }
+
+  // The sums of squares and cross products around the mean
+  Sym2 scatter() const {
+    Sym2 out = {sxx, sxy, syy};
+    return out;
+  }
+
+  // The sample covariance matrix
+  Sym2 covariance() const {
+    return scatter() * (1.0 / (n - 1));
+  }
+};
+
+} // namespace articulated
+
+#endif
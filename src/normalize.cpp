@@ -0,0 +1,85 @@
+#include <Rcpp.h>
+#include "normalize.h"
+#include "vowelspace_grouped.h"
+#include "vowelspace_rcpp.h"
+#include "vsd.h"
+#include "vsd_grouped.h"
+#include "vsd_rcpp.h"
+#include <string>
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// Native backend of normalize.formants(). The normalised formants are
+// written into newly allocated vectors, and if requested the grouped vowel
+// spaces and the grouped VSD over the grid seq(-1 + gridres/2, 1.5,
+// gridres) are computed directly from those, without going back through R.
+// [[Rcpp::export]]
+List cppNormalizeFormants(NumericVector f1,
+                          NumericVector f2,
+                          IntegerVector group,
+                          int ngroups,
+                          std::string method = "lobanov",
+                          bool vowelspace = false,
+                          std::string centermethod = "wcentroid",
+                          int minvectors = 3,
+                          int threads = 0,
+                          bool vsd = false,
+                          double resolution = 0.05,
+                          double gridres = 0.01,
+                          double threshold = 0.25,
+                          std::string vsdmethod = "count") {
+  if(f1.size() != f2.size() || f1.size() != group.size()) {
+    Rcpp::stop("The F1, F2 and group vectors must be of the same length.");
+  }
+  NormMethod nm;
+  if(!norm_method_from_name(method, nm)) {
+    Rcpp::stop("Unknown normalization method \"" + method + "\".");
+  }
+  CenterMethod cm = center_method(centermethod);
+  bool smooth = false;
+  DensityKernel kernel = KERNEL_GAUSSIAN;
+  if(vsd) {
+    if(nm == NORM_LOBANOV) {
+      Rcpp::stop("The VSD divides the formants by their medians, which is not meaningful for Lobanov z-scores; use another normalization method.");
+    }
+    if(!(gridres > 0 && gridres < 2.5)) {
+      Rcpp::stop("The grid resolution must be positive and below 2.5.");
+    }
+    vsd_method(vsdmethod, resolution, smooth, kernel);
+  }
+  int nthreads = resolve_threads(threads);
+  std::size_t n = f1.size();
+
+  GroupIndex gi(group.begin(), n, ngroups);
+  GroupedVowelSpace raw;
+  if(nm == NORM_WATT_FABRICIUS) {
+    grouped_vowel_space(f1.begin(), f2.begin(), gi, cm, minvectors, nthreads, raw);
+  }
+  std::vector<FormantScale> scales;
+  group_scales(f1.begin(), f2.begin(), group.begin(), n, ngroups, nm, &raw, scales);
+
+  NumericVector n1(n), n2(n);
+  apply_scales(f1.begin(), f2.begin(), group.begin(), n, ngroups, nm, scales,
+               nthreads, n1.begin(), n2.begin());
+
+  List out = List::create(Named("f1") = n1, Named("f2") = n2);
+  if(vowelspace) {
+    GroupedVowelSpace vs;
+    grouped_vowel_space(n1.begin(), n2.begin(), gi, cm, minvectors, nthreads, vs);
+    out.push_back(grouped_vowel_space_list(gi, vs), "Vowel space");
+  }
+  if(vsd) {
+    UniformGrid ug(-1 + gridres / 2, 1.5, gridres);
+    std::vector<double> grid(ug.m);
+    for(int i = 0; i < ug.m; ++i) {
+      grid[i] = ug[i];
+    }
+    std::vector<GroupVSD> res;
+    grouped_vsd(n1.begin(), n2.begin(), gi, grid.data(), ug.m, resolution,
+                threshold, smooth, kernel, nthreads, res);
+    out.push_back(grouped_vsd_list(gi, res, grid.data(), ug.m), "VSD");
+  }
+  return out;
+}
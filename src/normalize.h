@@ -0,0 +1,185 @@
+#ifndef ARTICULATED_NORMALIZE_H
+#define ARTICULATED_NORMALIZE_H
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "vowelspace.h"
+#include "vowelspace_grouped.h"
+
+// Speaker normalisation of formant frequencies. The speaker dependent
+// methods reduce to an affine transform of each formant,
+//
+//   (F - shift) / scale,
+//
+// with the shift and scale computed per speaker (group) in a single pass
+// over the tokens, after which all tokens are transformed in a second pass.
+
+namespace articulated {
+
+enum NormMethod {
+  NORM_LOBANOV,         // z-scores
+  NORM_NEAREY1,         // F divided by the geometric mean of the formant
+  NORM_NEAREY2,         // F divided by the geometric mean of both formants
+  NORM_WATT_FABRICIUS,  // F divided by the centroid of the [i], [a] and [u'] corners
+  NORM_BARK,            // Traunmuller (1990) Bark scale, no speaker statistics
+  NORM_ERB              // Glasberg & Moore (1990) ERB rate, no speaker statistics
+};
+
+inline bool norm_method_from_name(const std::string& name, NormMethod& method) {
+  if(name == "lobanov") method = NORM_LOBANOV;
+  else if(name == "nearey1") method = NORM_NEAREY1;
+  else if(name == "nearey2") method = NORM_NEAREY2;
+  else if(name == "wattfabricius") method = NORM_WATT_FABRICIUS;
+  else if(name == "bark") method = NORM_BARK;
+  else if(name == "erb") method = NORM_ERB;
+  else return false;
+  return true;
+}
+
+// Welford's running mean and variance. Missing values are skipped.
+struct Moments {
+  std::size_t n;
+  double mean;
+  double m2;
+
+  Moments() : n(0), mean(0), m2(0) {}
+
+  void add(double x) {
+    if(std::isnan(x)) return;
+    ++n;
+    double d = x - mean;
+    mean += d / n;
+    m2 += d * (x - mean);
+  }
+
+  double value() const {
+    return n > 0 ? mean : na_real();
+  }
+
+  double sd() const {
+    return n > 1 ? std::sqrt(m2 / (n - 1)) : na_real();
+  }
+};
+
+struct FormantScale {
+  double shift1, scale1;
+  double shift2, scale2;
+};
+
+// Computes the shift and scale of each formant for every group. Group codes
+// are 1-based. The Watt-Fabricius method needs the vowel spaces of the groups
+// (computed on the raw formants), as the [i] and [a] corner vowels stand in
+// for the point vowels of the method; the other methods ignore vs.
+inline void group_scales(const double* f1, const double* f2, const int* group,
+                         std::size_t n, int ngroups, NormMethod method,
+                         const GroupedVowelSpace* vs,
+                         std::vector<FormantScale>& out) {
+  out.assign(ngroups, FormantScale());
+  if(method == NORM_WATT_FABRICIUS) {
+    for(int g = 0; g < ngroups; ++g) {
+      const CornerSet& cs = vs->corners[g];
+      double iF1 = na_real(), iF2 = na_real(), aF1 = na_real(), aF2 = na_real();
+      for(int k = 0; k < cs.n; ++k) {
+        if(cs.which[k] == 1) { iF1 = cs.f1[k]; iF2 = cs.f2[k]; }
+        if(cs.which[k] == 3) { aF1 = cs.f1[k]; aF2 = cs.f2[k]; }
+      }
+      // The [u'] point has both F1 and F2 equal to the F1 of [i]
+      out[g].shift1 = 0;
+      out[g].shift2 = 0;
+      out[g].scale1 = (iF1 + aF1 + iF1) / 3;
+      out[g].scale2 = (iF2 + aF2 + iF1) / 3;
+    }
+    return;
+  }
+
+  bool logs = method == NORM_NEAREY1 || method == NORM_NEAREY2;
+  std::vector<Moments> m1(ngroups), m2(ngroups), both(ngroups);
+  for(std::size_t i = 0; i < n; ++i) {
+    int g = group[i] - 1;
+    if(g < 0 || g >= ngroups) continue;
+    double x1 = logs ? std::log(f1[i]) : f1[i];
+    double x2 = logs ? std::log(f2[i]) : f2[i];
+    m1[g].add(x1);
+    m2[g].add(x2);
+    if(method == NORM_NEAREY2) {
+      both[g].add(x1);
+      both[g].add(x2);
+    }
+  }
+
+  for(int g = 0; g < ngroups; ++g) {
+    FormantScale& s = out[g];
+    switch(method) {
+    case NORM_LOBANOV:
+      s.shift1 = m1[g].value();
+      s.scale1 = m1[g].sd();
+      s.shift2 = m2[g].value();
+      s.scale2 = m2[g].sd();
+      break;
+    case NORM_NEAREY1:
+      s.shift1 = 0;
+      s.scale1 = std::exp(m1[g].value());
+      s.shift2 = 0;
+      s.scale2 = std::exp(m2[g].value());
+      break;
+    case NORM_NEAREY2:
+      s.shift1 = 0;
+      s.scale1 = std::exp(both[g].value());
+      s.shift2 = 0;
+      s.scale2 = s.scale1;
+      break;
+    default:
+      s.shift1 = 0;
+      s.scale1 = 1;
+      s.shift2 = 0;
+      s.scale2 = 1;
+    }
+  }
+}
+
+inline double hz_to_bark(double f) {
+  return 26.81 * f / (1960 + f) - 0.53;
+}
+
+inline double hz_to_erb(double f) {
+  return 21.4 * std::log10(1 + 0.00437 * f);
+}
+
+// Writes the normalised formants into out1 and out2, which must hold n
+// values each. Tokens without a valid group get missing values, except for
+// the Bark and ERB scales, which do not depend on the speaker.
+inline void apply_scales(const double* f1, const double* f2, const int* group,
+                         std::size_t n, int ngroups, NormMethod method,
+                         const std::vector<FormantScale>& scales, int threads,
+                         double* out1, double* out2) {
+  long nn = (long) n;
+#pragma omp parallel for num_threads(threads) schedule(static)
+  for(long i = 0; i < nn; ++i) {
+    if(method == NORM_BARK) {
+      out1[i] = hz_to_bark(f1[i]);
+      out2[i] = hz_to_bark(f2[i]);
+      continue;
+    }
+    if(method == NORM_ERB) {
+      out1[i] = hz_to_erb(f1[i]);
+      out2[i] = hz_to_erb(f2[i]);
+      continue;
+    }
+    int g = group[i] - 1;
+    if(g < 0 || g >= ngroups) {
+      out1[i] = na_real();
+      out2[i] = na_real();
+      continue;
+    }
+    const FormantScale& s = scales[g];
+    out1[i] = (f1[i] - s.shift1) / s.scale1;
+    out2[i] = (f2[i] - s.shift2) / s.scale2;
+  }
+}
+
+} // namespace articulated
+
+#endif
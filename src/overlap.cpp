@@ -0,0 +1,55 @@
+#include <Rcpp.h>
+#include "overlap.h"
+#include "parallel.h"
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// Native backend of vowel.overlap(). Returns one row per group and pair of
+// categories, with groups and categories given by their 1-based codes.
+// [[Rcpp::export]]
+DataFrame cppVowelOverlap(NumericVector f1,
+                          NumericVector f2,
+                          IntegerVector category,
+                          int ncategories,
+                          IntegerVector group,
+                          int ngroups,
+                          IntegerVector pairA,
+                          IntegerVector pairB,
+                          int threads = 0) {
+  if(f1.size() != f2.size() || f1.size() != category.size() ||
+     f1.size() != group.size()) {
+    Rcpp::stop("The F1, F2, vowel and group vectors must be of the same length.");
+  }
+  if(pairA.size() != pairB.size()) {
+    Rcpp::stop("Both vowels of each pair must be given.");
+  }
+  int npairs = pairA.size();
+  GroupIndex gi(group.begin(), group.size(), ngroups);
+  std::size_t nrows = (std::size_t) ngroups * npairs;
+  std::vector<Overlap> overlap(nrows);
+  std::vector<std::size_t> counts(2 * nrows);
+  grouped_overlap(f1.begin(), f2.begin(), category.begin(), ncategories, gi,
+                  pairA.begin(), pairB.begin(), npairs, resolve_threads(threads),
+                  overlap.data(), counts.data());
+
+  IntegerVector ogroup(nrows), oa(nrows), ob(nrows), na(nrows), nb(nrows);
+  NumericVector pillai(nrows), bhatt(nrows);
+  for(std::size_t r = 0; r < nrows; ++r) {
+    ogroup[r] = r / npairs + 1;
+    oa[r] = pairA[r % npairs];
+    ob[r] = pairB[r % npairs];
+    na[r] = counts[2 * r];
+    nb[r] = counts[2 * r + 1];
+    pillai[r] = overlap[r].pillai;
+    bhatt[r] = overlap[r].bhattacharyya;
+  }
+  return DataFrame::create(Named("group") = ogroup,
+                           Named("vowel1") = oa,
+                           Named("vowel2") = ob,
+                           Named("n1") = na,
+                           Named("n2") = nb,
+                           Named("pillai") = pillai,
+                           Named("bhattacharyya") = bhatt);
+}
@@ -0,0 +1,101 @@
+#ifndef ARTICULATED_OVERLAP_H
+#define ARTICULATED_OVERLAP_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "matrix2.h"
+#include "parallel.h"
+#include "vowelspace.h"
+
+// Overlap between pairs of vowel categories in the F2/F1 plane, computed
+// from the means and covariances of the categories.
+
+namespace articulated {
+
+struct Overlap {
+  double pillai;
+  double bhattacharyya;
+};
+
+// The Pillai trace of a one-way MANOVA with two groups, trace(H (H + E)^-1).
+// With two groups the hypothesis matrix has rank one, H = k d d' with
+// k = na nb / (na + nb) and d the difference in means, so the trace is
+// k d' (H + E)^-1 d.
+inline double pillai_trace(const Moments2& a, const Moments2& b) {
+  if(a.n < 2 || b.n < 2) return na_real();
+  double k = (double) a.n * b.n / (a.n + b.n);
+  double dx = a.mx - b.mx;
+  double dy = a.my - b.my;
+  Sym2 h = {k * dx * dx, k * dx * dy, k * dy * dy};
+  Sym2 t = h + a.scatter() + b.scatter();
+  return k * t.inverse().quad(dx, dy);
+}
+
+// The Bhattacharyya affinity exp(-D) of two bivariate normal distributions,
+// where D is the Bhattacharyya distance
+//
+//   D = d' S^-1 d / 8 + log(det(S) / sqrt(det(Sa) det(Sb))) / 2
+//
+// and S is the average of the covariance matrices Sa and Sb.
+inline double bhattacharyya_affinity(const Moments2& a, const Moments2& b) {
+  if(a.n < 2 || b.n < 2) return na_real();
+  Sym2 sa = a.covariance();
+  Sym2 sb = b.covariance();
+  Sym2 s = (sa + sb) * 0.5;
+  double dx = a.mx - b.mx;
+  double dy = a.my - b.my;
+  double dist = s.inverse().quad(dx, dy) / 8 +
+    0.5 * std::log(s.det() / std::sqrt(sa.det() * sb.det()));
+  return std::exp(-dist);
+}
+
+// Computes the overlap of the category pairs (pairA[p], pairB[p]) within
+// every group. Categories and groups are given by 1-based codes. The tokens
+// of each group are read once to collect the moments of all categories, from
+// which every requested pair is computed; groups are processed in parallel.
+// out must hold ngroups * npairs results, stored group by group, and counts
+// the corresponding ngroups * npairs * 2 category sizes.
+inline void grouped_overlap(const double* f1, const double* f2,
+                            const int* category, int ncategories,
+                            const GroupIndex& gi, const int* pairA,
+                            const int* pairB, int npairs, int threads,
+                            Overlap* out, std::size_t* counts) {
+  int ngroups = gi.ngroups();
+#pragma omp parallel num_threads(threads)
+{
+  std::vector<Moments2> moments(ncategories);
+#pragma omp for schedule(dynamic)
+  for(int g = 0; g < ngroups; ++g) {
+    moments.assign(ncategories, Moments2());
+    const std::size_t* idx = gi.index.data() + gi.offset[g];
+    for(std::size_t i = 0; i < gi.size(g); ++i) {
+      std::size_t t = idx[i];
+      int c = category[t] - 1;
+      if(c < 0 || c >= ncategories) continue;
+      moments[c].add(f2[t], f1[t]);
+    }
+    for(int p = 0; p < npairs; ++p) {
+      std::size_t r = (std::size_t) g * npairs + p;
+      int a = pairA[p] - 1;
+      int b = pairB[p] - 1;
+      if(a < 0 || a >= ncategories || b < 0 || b >= ncategories) {
+        out[r].pillai = na_real();
+        out[r].bhattacharyya = na_real();
+        counts[2 * r] = 0;
+        counts[2 * r + 1] = 0;
+        continue;
+      }
+      out[r].pillai = pillai_trace(moments[a], moments[b]);
+      out[r].bhattacharyya = bhattacharyya_affinity(moments[a], moments[b]);
+      counts[2 * r] = moments[a].n;
+      counts[2 * r + 1] = moments[b].n;
+    }
+  }
+}
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef ARTICULATED_PARALLEL_H
+#define ARTICULATED_PARALLEL_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Helpers for the grouped (multi speaker) computations, which are run over
+// groups on an OpenMP thread team. None of the code running inside a
+// parallel region may touch the R API.
+
+namespace articulated {
+
+// The number of threads to use. Zero or a negative value means all threads
+// that OpenMP makes available. Builds without OpenMP always use one thread.
+inline int resolve_threads(int threads) {
+#ifdef _OPENMP
+  if(threads <= 0) return omp_get_max_threads();
+  return threads;
+#else
+  (void) threads;
+  return 1;
+#endif
+}
+
+inline int thread_id() {
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+// A bump allocator for per-group scratch memory. Each worker thread owns one
+// arena, reserves enough space for the group it is about to process and then
+// hands out slices of it. The memory is reused for the next group, so after
+// the largest group has been seen no further allocations are made.
+class Arena {
+public:
+  // Rewinds the arena and makes sure that at least 'bytes' bytes can be
+  // handed out before the next reset. Pointers from earlier allocations are
+  // invalidated.
+  void reset(std::size_t bytes) {
+    std::size_t words = (bytes + sizeof(Word) - 1) / sizeof(Word);
+    // Leave room for aligning every slice
+    words += SLACK;
+    if(buffer.size() < words) buffer.resize(words);
+    used = 0;
+  }
+
+  template <typename T>
+  T* alloc(std::size_t n) {
+    std::size_t words = (n * sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+    if(used + words > buffer.size()) {
+      throw std::length_error("Arena exhausted; reserve more space before allocating.");
+    }
+    T* out = reinterpret_cast<T*>(buffer.data() + used);
+    used += words;
+    return out;
+  }
+
+  // Bytes needed to allocate n objects of type T, including alignment.
+  template <typename T>
+  static std::size_t bytes_for(std::size_t n) {
+    return ((n * sizeof(T) + sizeof(Word) - 1) / sizeof(Word)) * sizeof(Word);
+  }
+
+private:
+  typedef double Word;
+  static const std::size_t SLACK = 8;
+  std::vector<Word> buffer;
+  std::size_t used = 0;
+};
+
+// Splits token indices by group. Group codes are 1-based (as for factor
+// codes in R); tokens with a code outside 1..ngroups are dropped. After
+// construction the tokens of group g (0-based) are
+// index[offset[g]] .. index[offset[g + 1] - 1], in their original order.
+struct GroupIndex {
+  std::vector<std::size_t> offset;
+  std::vector<std::size_t> index;
+
+  GroupIndex(const int* group, std::size_t n, int ngroups)
+    : offset(ngroups + 1, 0) {
+    for(std::size_t i = 0; i < n; ++i) {
+      int g = group[i];
+      if(g >= 1 && g <= ngroups) ++offset[g];
+    }
+    for(int g = 0; g < ngroups; ++g) {
+      offset[g + 1] += offset[g];
+    }
+    index.resize(offset[ngroups]);
+    std::vector<std::size_t> pos(offset.begin(), offset.end() - 1);
+    for(std::size_t i = 0; i < n; ++i) {
+      int g = group[i];
+      if(g >= 1 && g <= ngroups) index[pos[g - 1]++] = i;
+    }
+  }
+
+  int ngroups() const {
+    return (int) offset.size() - 1;
+  }
+
+  std::size_t size(int g) const {
+    return offset[g + 1] - offset[g];
+  }
+
+  std::size_t largest() const {
+    std::size_t out = 0;
+    for(int g = 0; g < ngroups(); ++g) {
+      if(size(g) > out) out = size(g);
+    }
+    return out;
+  }
+};
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,233 @@
+#include <Rcpp.h>
+#include "voice.h"
+#include "vrp.h"
+#include "vrp_stream.h"
+#include "wav.h"
+#include "parallel.h"
+#include <string>
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// Reads a WAVE file, mixed down to mono samples in [-1, 1], with the level
+// (dB) of full scale on the scale of its integer samples.
+// [[Rcpp::export]]
+List cppReadWav(std::string file) {
+  WavReader wav;
+  std::string error;
+  if(!wav.open(file, error)) {
+    Rcpp::stop(error);
+  }
+  std::vector<double> samples(wav.frames());
+  std::size_t got = 0, m;
+  while(got < samples.size() &&
+        (m = wav.read(samples.data() + got, samples.size() - got)) > 0) {
+    got += m;
+  }
+  samples.resize(got);
+  return List::create(Named("samples") = NumericVector(samples.begin(), samples.end()),
+                      Named("rate") = wav.rate(),
+                      Named("full_scale") = wav.full_scale_db());
+}
+
+// The sample rate, number of channels, number of sample frames and level
+// (dB) of full scale of a WAVE file, from its header.
+// [[Rcpp::export]]
+List cppWavInfo(std::string file) {
+  WavReader wav;
+  std::string error;
+  if(!wav.open(file, error)) {
+    Rcpp::stop(error);
+  }
+  return List::create(Named("rate") = wav.rate(),
+                      Named("channels") = wav.channels(),
+                      Named("frames") = (double) wav.frames(),
+                      Named("full_scale") = wav.full_scale_db());
+}
+
+// Native backend of voice.frames(). Tracks the F0 (YIN), in Hz and in
+// semitones, and the RMS level of a sound in one pass over a frame grid.
+// 'shift' and 'window' are in seconds. Levels are in dB re full scale plus
+// 'fullscale', the level given to full scale.
+// [[Rcpp::export]]
+DataFrame cppVoiceFrames(NumericVector samples,
+                         double rate,
+                         double minf = 50,
+                         double maxf = 600,
+                         double shift = 0.005,
+                         double window = 0.02,
+                         double threshold = 0.1,
+                         double fullscale = 0,
+                         int threads = 0) {
+  if(!(rate > 0) || !(minf > 0) || !(maxf > minf)) {
+    Rcpp::stop("The sample rate and the F0 range must be positive, with a maximum above the minimum.");
+  }
+  if(!(shift > 0) || !(window > 0)) {
+    Rcpp::stop("The window shift and size must be positive.");
+  }
+  threads = resolve_threads(threads);
+  Yin yin(rate, minf, maxf, threshold);
+  std::size_t w = std::max<std::size_t>(1, (std::size_t) (window * rate + 0.5));
+  FrameGrid grid = voice_grid(rate, shift, yin, w);
+  std::size_t n = samples.size();
+  std::size_t nf = grid.frames(n);
+
+  NumericVector time(nf), f0(nf), voicing(nf), st(nf), rms(nf);
+  for(std::size_t i = 0; i < nf; ++i) {
+    time[i] = grid.time(i);
+  }
+  VoiceTracks out = {f0.begin(), voicing.begin(), st.begin(), rms.begin()};
+  voice_track(samples.begin(), n, grid, yin, w, threads, out);
+  for(std::size_t i = 0; i < nf; ++i) {
+    rms[i] += fullscale;
+  }
+  return DataFrame::create(Named("time") = time,
+                           Named("F0") = f0,
+                           Named("voicing") = voicing,
+                           Named("st") = st,
+                           Named("rms") = rms);
+}
+
+// Native backend of voice.range.profile(). Bins the frames of many
+// recordings, given as lists of semitone and level tracks, into VRP
+// histograms, in parallel over recordings. Returns the non-empty bins of
+// all recordings as a sparse table: the 1-based recording, the pitch and
+// level of the bin and the number of frames in it.
+// [[Rcpp::export]]
+DataFrame cppVoiceRangeProfile(List semitones,
+                               List levels,
+                               double stbin = 5,
+                               double dbbin = 5,
+                               int threads = 0) {
+  int nrec = semitones.size();
+  if(levels.size() != nrec) {
+    Rcpp::stop("There must be one level track for every semitone track.");
+  }
+  if(!(stbin > 0) || !(dbbin > 0)) {
+    Rcpp::stop("The bin sizes must be positive.");
+  }
+  std::vector<NumericVector> st(nrec), db(nrec);
+  for(int r = 0; r < nrec; ++r) {
+    st[r] = semitones[r];
+    db[r] = levels[r];
+    if(st[r].size() != db[r].size()) {
+      Rcpp::stop("The semitone and level tracks of a recording must be of the same length.");
+    }
+  }
+
+  std::vector<Histogram2> hist(nrec);
+  std::vector<const double*> px(nrec), py(nrec);
+  std::vector<std::size_t> len(nrec);
+  for(int r = 0; r < nrec; ++r) {
+    px[r] = st[r].begin();
+    py[r] = db[r].begin();
+    len[r] = st[r].size();
+  }
+#pragma omp parallel for num_threads(resolve_threads(threads)) schedule(dynamic)
+  for(int r = 0; r < nrec; ++r) {
+    histogram2(px[r], py[r], len[r], stbin, dbbin, hist[r]);
+  }
+
+  std::size_t total = 0;
+  for(int r = 0; r < nrec; ++r) {
+    total += occupied(hist[r]);
+  }
+  IntegerVector recording(total), count(total);
+  NumericVector pitch(total), amp(total);
+  std::size_t k = 0;
+  for(int r = 0; r < nrec; ++r) {
+    for_each_bin(hist[r], [&](double x, double y, int c) {
+      recording[k] = r + 1;
+      pitch[k] = x;
+      amp[k] = y;
+      count[k] = c;
+      ++k;
+    });
+  }
+  return DataFrame::create(Named("recording") = recording,
+                           Named("pitch") = pitch,
+                           Named("amp") = amp,
+                           Named("n") = count);
+}
+
+// Native backend of voice.range.stream(). 'shift' and 'window' are in
+// seconds, and 'fullscale' is as for cppVoiceFrames().
+// [[Rcpp::export]]
+SEXP cppVRPStreamNew(double rate,
+                     double minf = 50,
+                     double maxf = 600,
+                     double shift = 0.005,
+                     double window = 0.02,
+                     double threshold = 0.1,
+                     double stbin = 5,
+                     double dbbin = 5,
+                     double fullscale = 0) {
+  if(!(rate > 0) || !(minf > 0) || !(maxf > minf)) {
+    Rcpp::stop("The sample rate and the F0 range must be positive, with a maximum above the minimum.");
+  }
+  if(!(shift > 0) || !(window > 0)) {
+    Rcpp::stop("The window shift and size must be positive.");
+  }
+  if(!(stbin > 0) || !(dbbin > 0)) {
+    Rcpp::stop("The bin sizes must be positive.");
+  }
+  XPtr<VRPStream> ptr(new VRPStream(rate, minf, maxf, shift, window, threshold,
+                                    stbin, dbbin, fullscale), true);
+  return ptr;
+}
+
+// [[Rcpp::export]]
+void cppVRPStreamAdd(SEXP stream, NumericVector samples, int threads = 0) {
+  XPtr<VRPStream> vrp(stream);
+  vrp->add(samples.begin(), samples.size(), resolve_threads(threads));
+}
+
+// Streams a WAVE file into a VRP stream, 'block' sample frames at a time.
+// The file must have the sample rate of the stream.
+// [[Rcpp::export]]
+void cppVRPStreamAddFile(SEXP stream, std::string file, int block = 65536,
+                         int threads = 0) {
+  XPtr<VRPStream> vrp(stream);
+  WavReader wav;
+  std::string error;
+  if(!wav.open(file, error)) {
+    Rcpp::stop(error);
+  }
+  if(wav.rate() != vrp->rate()) {
+    Rcpp::stop("The sample rate of the file (" + std::to_string((long) wav.rate()) +
+               " Hz) differs from that of the stream.");
+  }
+  if(block < 1) {
+    Rcpp::stop("The block size must be positive.");
+  }
+  threads = resolve_threads(threads);
+  std::vector<double> x(block);
+  std::size_t m;
+  while((m = wav.read(x.data(), block)) > 0) {
+    vrp->add(x.data(), m, threads);
+  }
+}
+
+// The voice range profile of the sound added to a VRP stream so far, as a
+// sparse table of the non-empty bins.
+// [[Rcpp::export]]
+List cppVRPStreamState(SEXP stream) {
+  XPtr<VRPStream> vrp(stream);
+  const Histogram2& h = vrp->profile();
+  std::size_t nb = occupied(h), k = 0;
+  NumericVector pitch(nb), amp(nb);
+  IntegerVector count(nb);
+  for_each_bin(h, [&](double x, double y, int c) {
+    pitch[k] = x;
+    amp[k] = y;
+    count[k] = c;
+    ++k;
+  });
+  return List::create(Named("VRP") = DataFrame::create(Named("pitch") = pitch,
+                                                       Named("amp") = amp,
+                                                       Named("n") = count),
+                      Named("Frames") = (double) vrp->frames(),
+                      Named("Voiced") = (double) vrp->voiced(),
+                      Named("Duration") = vrp->length() / vrp->rate());
+}
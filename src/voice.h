@@ -0,0 +1,246 @@
+#ifndef ARTICULATED_VOICE_H
+#define ARTICULATED_VOICE_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "fft.h"
+#include "parallel.h"
+#include "vowelspace.h"
+
+// Framewise F0 (YIN) and intensity (RMS) analysis of a sound, on a frame
+// grid shared by both measures.
+
+namespace articulated {
+
+// Frames of 'span' samples, taken every 'hop' samples. Frame i starts at
+// sample round(i * hop), and only frames that lie entirely within the
+// sound are analysed. The time of a frame is the time of its center.
+struct FrameGrid {
+  double rate;
+  double hop;
+  std::size_t span;
+
+  std::size_t start(std::size_t i) const {
+    return (std::size_t) std::floor(i * hop + 0.5);
+  }
+
+  double time(std::size_t i) const {
+    return (start(i) + span / 2.0) / rate;
+  }
+
+  // The number of frames in a sound of n samples
+  std::size_t frames(std::size_t n) const {
+    if(n < span) return 0;
+    std::size_t m = (std::size_t) ((n - span) / hop) + 1;
+    while(m > 0 && start(m - 1) + span > n) --m;
+    while(start(m) + span <= n) ++m;
+    return m;
+  }
+};
+
+// The YIN F0 estimator (de Cheveigne and Kawahara, 2002).
+//
+// For lags tau up to taumax = ceil(rate / minf), the difference function
+//
+//   d(tau) = sum_{j < W} (x_j - x_{j + tau})^2,  W = taumax,
+//
+// is computed as e_0 + e_tau - 2 r(tau) from running sums of squares e and
+// the cross-correlation r of the first W samples with the whole buffer of
+// 2 taumax samples. r is computed by FFT: both real sequences are packed
+// into one complex transform, and one inverse transform of the
+// cross-spectrum gives r for all lags. The F0 is taken from the first dip
+// of the cumulative mean normalised difference d' below 'threshold' (at
+// lags above rate / maxf), refined by parabolic interpolation. Frames
+// without such a dip are unvoiced.
+class Yin {
+public:
+  // Scratch space for one frame; each thread needs its own.
+  struct Workspace {
+    std::vector<std::complex<double> > z, p;
+    std::vector<double> energy, d;
+  };
+
+  Yin(double rate, double minf, double maxf, double threshold)
+    : rate(rate), threshold(threshold),
+      taumax((std::size_t) std::ceil(rate / minf)),
+      taumin(std::max<std::size_t>(2, (std::size_t) std::floor(rate / maxf))),
+      fft(2 * taumax) {}
+
+  // The number of samples analysed per frame
+  std::size_t span() const {
+    return 2 * taumax;
+  }
+
+  void prepare(Workspace& ws) const {
+    std::size_t n = fft.size();
+    ws.z.resize(n);
+    ws.p.resize(n);
+    ws.energy.resize(span() + 1);
+    ws.d.resize(taumax + 1);
+  }
+
+  // Estimates the F0 of the span() samples at x. Returns the F0, or a
+  // missing value for unvoiced frames, and sets 'voicing' to 1 - d' at the
+  // chosen lag (the periodicity of the frame).
+  double estimate(const double* x, Workspace& ws, double& voicing) const {
+    std::size_t n = fft.size(), w = taumax, len = span();
+    std::complex<double>* z = ws.z.data();
+    for(std::size_t j = 0; j < n; ++j) {
+      double a = j < w ? x[j] : 0;
+      double b = j < len ? x[j] : 0;
+      z[j] = std::complex<double>(a, b);
+    }
+    fft.transform(z, false);
+    // Unpack the two spectra and form the cross-spectrum conj(A) B
+    std::complex<double>* p = ws.p.data();
+    for(std::size_t k = 0; k < n; ++k) {
+      std::complex<double> zk = z[k], zn = std::conj(z[(n - k) % n]);
+      std::complex<double> a = (zk + zn) * 0.5;
+      std::complex<double> b = (zk - zn) * std::complex<double>(0, -0.5);
+      p[k] = std::conj(a) * b;
+    }
+    fft.transform(p, true);
+
+    double* e = ws.energy.data();
+    e[0] = 0;
+    for(std::size_t j = 0; j < len; ++j) {
+      e[j + 1] = e[j] + x[j] * x[j];
+    }
+    voicing = 0;
+    if(!(e[len] > 0)) return na_real();
+
+    // The cumulative mean normalised difference function
+    double* d = ws.d.data();
+    double e0 = e[w], sum = 0;
+    d[0] = 1;
+    for(std::size_t tau = 1; tau <= taumax; ++tau) {
+      double r = p[tau].real() / n;
+      double dt = std::max(0.0, e0 + (e[tau + w] - e[tau]) - 2 * r);
+      sum += dt;
+      d[tau] = sum > 0 ? dt * tau / sum : 1;
+    }
+
+    std::size_t best = 0;
+    for(std::size_t tau = taumin; tau <= taumax; ++tau) {
+      if(d[tau] < threshold) {
+        while(tau < taumax && d[tau + 1] < d[tau]) ++tau;
+        best = tau;
+        break;
+      }
+    }
+    if(best == 0) {
+      double dmin = 1;
+      for(std::size_t tau = taumin; tau <= taumax; ++tau) {
+        dmin = std::min(dmin, d[tau]);
+      }
+      voicing = std::max(0.0, 1 - dmin);
+      return na_real();
+    }
+    voicing = std::max(0.0, 1 - d[best]);
+    double shift = 0;
+    if(best < taumax) {
+      double a = d[best - 1], b = d[best], c = d[best + 1];
+      double denom = a - 2 * b + c;
+      if(denom > 0) shift = 0.5 * (a - c) / denom;
+    }
+    return rate / (best + shift);
+  }
+
+private:
+  double rate, threshold;
+  std::size_t taumax, taumin;
+  FFT fft;
+};
+
+// The RMS level in dB (re full scale) of a frame of n samples, weighted by
+// a window w: 20 log10(sqrt(sum (w x)^2 / sum w^2)). Silent frames get a
+// missing level.
+inline double rms_db(const double* x, const double* w, std::size_t n) {
+  double num = 0, den = 0;
+  for(std::size_t i = 0; i < n; ++i) {
+    double v = w[i] * x[i];
+    num += v * v;
+    den += w[i] * w[i];
+  }
+  if(!(num > 0)) return na_real();
+  return 10 * std::log10(num / den);
+}
+
+// A Hamming window of n samples
+inline std::vector<double> hamming(std::size_t n) {
+  std::vector<double> w(n);
+  const double pi = 3.14159265358979323846;
+  for(std::size_t i = 0; i < n; ++i) {
+    w[i] = n > 1 ? 0.54 - 0.46 * std::cos(2 * pi * i / (n - 1)) : 1;
+  }
+  return w;
+}
+
+// The frame grid shared by the F0 and RMS analyses: every frame spans both
+// the YIN buffer and the RMS window, which are centered in the frame.
+inline FrameGrid voice_grid(double rate, double shift, const Yin& yin,
+                            std::size_t window) {
+  FrameGrid g = {rate, shift * rate, std::max(yin.span(), window)};
+  return g;
+}
+
+// The F0 in semitones re 16.352 Hz (C0), as hz2st().
+inline double hz_to_semitones(double f) {
+  return 12 * std::log2(f / 16.352);
+}
+
+// The framewise voice analysis: F0, voicing, the F0 in semitones and the
+// RMS level, each of grid.frames(n) values.
+struct VoiceTracks {
+  double* f0;
+  double* voicing;
+  double* semitones;
+  double* rms;
+};
+
+// Analyses the frames first, ..., first + count - 1 of a frame grid in a
+// single loop over frames, run in parallel. x holds the samples from sample
+// 'base' on, and must extend to the end of the last frame; the results of
+// frame first + k are stored at index k. Each frame is visited once: the
+// RMS level is computed over a Hamming window of 'window' samples and the
+// F0 by YIN, both centered in the frame, so the frame is read from memory
+// once and is still in cache for the second measure. The semitone value is
+// computed in the same loop.
+inline void voice_track_range(const double* x, std::size_t base,
+                              const FrameGrid& grid, const Yin& yin,
+                              std::size_t window, std::size_t first,
+                              std::size_t count, int threads,
+                              VoiceTracks out) {
+  std::size_t yoff = (grid.span - yin.span()) / 2;
+  std::size_t roff = (grid.span - window) / 2;
+  std::vector<double> w = hamming(window);
+#pragma omp parallel num_threads(threads)
+{
+  Yin::Workspace ws;
+  yin.prepare(ws);
+#pragma omp for schedule(static)
+  for(long k = 0; k < (long) count; ++k) {
+    const double* frame = x + (grid.start(first + k) - base);
+    out.rms[k] = rms_db(frame + roff, w.data(), window);
+    double f = yin.estimate(frame + yoff, ws, out.voicing[k]);
+    out.f0[k] = f;
+    out.semitones[k] = std::isnan(f) ? na_real() : hz_to_semitones(f);
+  }
+}
+}
+
+// Analyses all frames of the n samples at x (see voice_track_range()).
+inline void voice_track(const double* x, std::size_t n, const FrameGrid& grid,
+                        const Yin& yin, std::size_t window, int threads,
+                        VoiceTracks out) {
+  voice_track_range(x, 0, grid, yin, window, 0, grid.frames(n), threads,
+                    out);
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,154 @@
+#include <Rcpp.h>
+#include "vowelspace.h"
+#include "vowelspace_grouped.h"
+#include "vowelspace_rcpp.h"
+#include "vowelspace_stream.h"
+#include <string>
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// Native backend of vector.space(). All buffers are allocated once, with
+// the length of the input, before the vowel space is computed.
+// [[Rcpp::export]]
+List cppVectorSpace(NumericVector f1,
+                    NumericVector f2,
+                    double f1c,
+                    double f2c,
+                    int minvectors = 3) {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  int n = f1.size();
+  NumericVector norms(n), angles(n);
+  IntegerVector corner(n);
+  CornerSet cs;
+
+  vowel_space(f1.begin(), f2.begin(), n, f1c, f2c, minvectors,
+              norms.begin(), angles.begin(), corner.begin(), cs);
+
+  double areas[N_CORNERS];
+  int nareas;
+  double vsa;
+  corner_areas(cs, areas, nareas, vsa);
+  std::string vsaName = "VSA(" + std::to_string(cs.n) + ")";
+
+  return List::create(Named("F1 center") = f1c,
+                      Named("F2 center") = f2c,
+                      Named("Vector norms") = norms,
+                      Named("Vector angles") = angles,
+                      Named("Which vowel corner") = corner_factor(corner),
+                      Named("Mean vectors") = mean_vectors(cs),
+                      Named("Corner vowels") = corner_vowels(cs),
+                      Named("Triangle areas") = NumericVector(areas, areas + nareas),
+                      Named(vsaName) = vsa);
+}
+
+// Native backend of vowelspace.center().
+// [[Rcpp::export]]
+List cppVowelspaceCenter(NumericVector f1,
+                         NumericVector f2,
+                         std::string method = "wcentroid",
+                         bool narm = true) {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  Center c = vowel_space_center(f1.begin(), f2.begin(), f1.size(),
+                                center_method(method), narm);
+  return List::create(Named("f2") = c.f2, Named("f1") = c.f1);
+}
+
+// Native backend of vector.space.by(). The tokens are split by group once,
+// and the groups are then processed in parallel.
+// [[Rcpp::export]]
+List cppGroupedVectorSpace(NumericVector f1,
+                           NumericVector f2,
+                           IntegerVector group,
+                           int ngroups,
+                           std::string method = "wcentroid",
+                           int minvectors = 3,
+                           int threads = 0) {
+  if(f1.size() != f2.size() || f1.size() != group.size()) {
+    Rcpp::stop("The F1, F2 and group vectors must be of the same length.");
+  }
+  GroupIndex gi(group.begin(), group.size(), ngroups);
+  GroupedVowelSpace vs;
+  grouped_vowel_space(f1.begin(), f2.begin(), gi, center_method(method),
+                      minvectors, resolve_threads(threads), vs);
+  return grouped_vowel_space_list(gi, vs);
+}
+
+// Native backend of vowelspace.area(). The shoelace sums of all groups are
+// accumulated in a single pass over the vertices, which therefore do not
+// need to be sorted by group.
+// [[Rcpp::export]]
+NumericVector cppPolygonAreas(NumericVector x,
+                              NumericVector y,
+                              IntegerVector group,
+                              int ngroups) {
+  if(x.size() != y.size() || x.size() != group.size()) {
+    Rcpp::stop("The coordinate and group vectors must be of the same length.");
+  }
+  std::vector<ShoelaceAccumulator> polygons(ngroups);
+  for(int i = 0; i < x.size(); ++i) {
+    int g = group[i];
+    if(g < 1 || g > ngroups) continue;
+    polygons[g - 1].add(x[i], y[i]);
+  }
+  NumericVector out(ngroups);
+  for(int g = 0; g < ngroups; ++g) {
+    out[g] = polygons[g].area();
+  }
+  return out;
+}
+
+// Native backend of vowelspace.stream() and friends. The state lives in an
+// external pointer, which is finalised when R garbage collects it.
+// [[Rcpp::export]]
+SEXP cppVowelspaceStreamNew(std::string method = "wcentroid",
+                            int minvectors = 3,
+                            double tolerance = 10) {
+  XPtr<VowelSpaceStream> ptr(new VowelSpaceStream(center_method(method),
+                                                  minvectors, tolerance), true);
+  return ptr;
+}
+
+// [[Rcpp::export]]
+void cppVowelspaceStreamAdd(SEXP stream, NumericVector f1, NumericVector f2) {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  XPtr<VowelSpaceStream> vs(stream);
+  for(int i = 0; i < f1.size(); ++i) {
+    vs->add(f1[i], f2[i]);
+  }
+}
+
+// [[Rcpp::export]]
+List cppVowelspaceStreamState(SEXP stream, bool rebin = false) {
+  XPtr<VowelSpaceStream> vs(stream);
+  if(rebin) {
+    vs->rebin();
+  }
+  Center c = vs->center();
+  Center ref = vs->reference();
+  CornerSet cs;
+  vs->corners(cs);
+  double areas[N_CORNERS];
+  int nareas;
+  double vsa;
+  corner_areas(cs, areas, nareas, vsa);
+  std::string vsaName = "VSA(" + std::to_string(cs.n) + ")";
+
+  return List::create(Named("F1 center") = c.f1,
+                      Named("F2 center") = c.f2,
+                      Named("Reference center") = NumericVector::create(Named("f2") = ref.f2,
+                                                                        Named("f1") = ref.f1),
+                      Named("Mean vectors") = mean_vectors(cs),
+                      Named("Corner vowels") = corner_vowels(cs),
+                      Named("Triangle areas") = NumericVector(areas, areas + nareas),
+                      Named(vsaName) = vsa,
+                      Named("Vowels") = (double) vs->size(),
+                      Named("Rebins") = (double) vs->rebins());
+}
@@ -0,0 +1,388 @@
+#ifndef ARTICULATED_VOWELSPACE_H
+#define ARTICULATED_VOWELSPACE_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+
+// Native kernels behind vector.space() and the functions that wrap it.
+// Everything here works on plain pointers into caller-owned buffers so that
+// the same code can be used for a single vowel space and for grouped
+// computations where the scratch memory is reused between groups.
+
+namespace articulated {
+
+// The corners are numbered in the order of the levels of the
+// "Which vowel corner" factor returned by vector.space().
+const int N_CORNERS = 4;
+const char* const CORNER_LABELS[N_CORNERS] = {
+  "[u]-corner", "[i]-corner", "[ae]-corner", "[a]-corner"
+};
+
+// qnorm(0.75). A corner only gets a mean vector if at least one of its
+// angles lies within the central 50% of a normal distribution fitted to the
+// angles of that corner, ie. abs(pnorm(angle) - 0.5) < 0.25.
+const double CENTRAL_HALF_Z = 0.6744897501960817;
+
+struct CornerSet {
+  int n;                     // The number of corners that got a mean vector
+  int which[N_CORNERS];      // Corner index (0 = [u] .. 3 = [a]) of each
+  double norm[N_CORNERS];    // Mean vector norm
+  double angle[N_CORNERS];   // Mean vector angle
+  double f2[N_CORNERS];      // Corner vowel F2
+  double f1[N_CORNERS];      // Corner vowel F1
+};
+
+inline double na_real() {
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+enum CenterMethod {
+  CENTER_CENTROID,
+  CENTER_TWOMEANS,
+  CENTER_WCENTROID
+};
+
+// Looks up a center method by the name used by vowelspace.center().
+// Returns false for unknown names.
+inline bool center_method_from_name(const std::string& name,
+                                    CenterMethod& method) {
+  if(name == "centroid") method = CENTER_CENTROID;
+  else if(name == "twomeans") method = CENTER_TWOMEANS;
+  else if(name == "wcentroid") method = CENTER_WCENTROID;
+  else return false;
+  return true;
+}
+
+struct Center {
+  double f2;
+  double f1;
+};
+
+// Running mean following the NA handling of mean(x, na.rm=narm): missing
+// values are skipped when narm is true and make the mean missing otherwise.
+// The sum is kept in extended precision, as R does.
+struct MeanAccumulator {
+  long double sum;
+  std::size_t n;
+  bool missing;
+
+  MeanAccumulator() : sum(0), n(0), missing(false) {}
+
+  void add(double x, bool narm) {
+    if(std::isnan(x)) {
+      if(!narm) missing = true;
+      return;
+    }
+    sum += x;
+    ++n;
+  }
+
+  double value() const {
+    if(missing || n == 0) return na_real();
+    return (double) (sum / n);
+  }
+};
+
+// Token access for the kernels. Tokens reads the formant vectors directly,
+// while IndexedTokens reads them through a vector of indices so that a
+// resampled set of vowels can be processed without copying the formants.
+struct Tokens {
+  const double* f1p;
+  const double* f2p;
+
+  Tokens(const double* f1, const double* f2) : f1p(f1), f2p(f2) {}
+  double f1(std::size_t i) const { return f1p[i]; }
+  double f2(std::size_t i) const { return f2p[i]; }
+};
+
+struct IndexedTokens {
+  const double* f1p;
+  const double* f2p;
+  const std::size_t* idx;
+
+  IndexedTokens(const double* f1, const double* f2, const std::size_t* index)
+    : f1p(f1), f2p(f2), idx(index) {}
+  double f1(std::size_t i) const { return f1p[idx[i]]; }
+  double f2(std::size_t i) const { return f2p[idx[i]]; }
+};
+
+// The center kernels. All methods start with a streaming pass for the F1
+// mean. The "twomeans" and "wcentroid" methods then make a second streaming
+// pass in which the F2 values of vowels below (and above) the F1 mean are
+// averaged. No temporary vectors are created.
+template <typename T>
+inline Center centroid_center(const T& tok, std::size_t n, bool narm) {
+  MeanAccumulator m1, m2;
+  for(std::size_t i = 0; i < n; ++i) {
+    m1.add(tok.f1(i), narm);
+    m2.add(tok.f2(i), narm);
+  }
+  Center c;
+  c.f1 = m1.value();
+  c.f2 = m2.value();
+  return c;
+}
+
+template <typename T>
+inline double f1_mean(const T& tok, std::size_t n, bool narm) {
+  MeanAccumulator m;
+  for(std::size_t i = 0; i < n; ++i) {
+    m.add(tok.f1(i), narm);
+  }
+  return m.value();
+}
+
+template <typename T>
+inline Center twomeans_center(const T& tok, std::size_t n, bool narm) {
+  Center c;
+  c.f1 = f1_mean(tok, n, narm);
+  c.f2 = na_real();
+  if(std::isnan(c.f1)) return c;
+
+  // A missing F1 value selects a missing F2 value, like f2[f1 > f1c] does.
+  MeanAccumulator high, low;
+  for(std::size_t i = 0; i < n; ++i) {
+    double f1 = tok.f1(i);
+    if(std::isnan(f1)) {
+      high.add(na_real(), narm);
+      low.add(na_real(), narm);
+    } else if(f1 > c.f1) {
+      high.add(tok.f2(i), narm);
+    } else if(f1 < c.f1) {
+      low.add(tok.f2(i), narm);
+    }
+  }
+  c.f2 = (high.value() + low.value()) / 2;
+  return c;
+}
+
+template <typename T>
+inline Center wcentroid_center(const T& tok, std::size_t n, bool narm) {
+  Center c;
+  c.f1 = f1_mean(tok, n, narm);
+  c.f2 = na_real();
+  if(std::isnan(c.f1)) return c;
+
+  MeanAccumulator low;
+  for(std::size_t i = 0; i < n; ++i) {
+    double f1 = tok.f1(i);
+    if(std::isnan(f1)) {
+      low.add(na_real(), narm);
+    } else if(f1 < c.f1) {
+      low.add(tok.f2(i), narm);
+    }
+  }
+  c.f2 = low.value();
+  return c;
+}
+
+// Computes the vowel space center as vowelspace.center() does.
+template <typename T>
+inline Center vowel_space_center(const T& tok, std::size_t n,
+                                 CenterMethod method, bool narm = true) {
+  switch(method) {
+  case CENTER_CENTROID:
+    return centroid_center(tok, n, narm);
+  case CENTER_TWOMEANS:
+    return twomeans_center(tok, n, narm);
+  default:
+    return wcentroid_center(tok, n, narm);
+  }
+}
+
+inline Center vowel_space_center(const double* f1, const double* f2,
+                                 std::size_t n, CenterMethod method,
+                                 bool narm = true) {
+  return vowel_space_center(Tokens(f1, f2), n, method, narm);
+}
+
+// Bins an angle into a vowel space corner using the same intervals as
+// cut(angle, breaks=c(-pi,-pi/2,0,pi/2,pi), include.lowest=TRUE), that is
+// [-pi,-pi/2], (-pi/2,0], (0,pi/2] and (pi/2,pi]. Returns -1 for missing
+// angles.
+inline int corner_of(double angle) {
+  if(std::isnan(angle)) return -1;
+  if(angle <= -M_PI / 2) return 0;
+  if(angle <= 0) return 1;
+  if(angle <= M_PI / 2) return 2;
+  return 3;
+}
+
+// Per-corner summaries of the vowel vectors, from which the mean vectors
+// and corner vowels are derived.
+struct CornerStats {
+  std::size_t count[N_CORNERS];
+  double sumNorm[N_CORNERS];
+  double sumAngle[N_CORNERS];
+  // Whether the corner passes the central 50% check (see CENTRAL_HALF_Z)
+  bool central[N_CORNERS];
+
+  CornerStats() {
+    for(int c = 0; c < N_CORNERS; ++c) {
+      count[c] = 0;
+      sumNorm[c] = 0;
+      sumAngle[c] = 0;
+      central[c] = false;
+    }
+  }
+};
+
+// Computes vector norms, angles and corners for n vowels relative to the
+// center (f2c,f1c), and summarises them by corner.
+//
+// norms, angles and corner must each hold n values. The first pass computes
+// the vectors and the per-corner running sums, the second pass computes the
+// spread of the angles within each corner.
+template <typename T>
+inline void corner_stats(const T& tok, std::size_t n, double f1c, double f2c,
+                         double* norms, double* angles, int* corner,
+                         CornerStats& st) {
+  st = CornerStats();
+  for(std::size_t i = 0; i < n; ++i) {
+    double d1 = tok.f1(i) - f1c;
+    double d2 = tok.f2(i) - f2c;
+    double norm = std::sqrt(d1 * d1 + d2 * d2);
+    double angle = std::atan2(d1, d2);
+    int c = std::isnan(norm) ? -1 : corner_of(angle);
+    norms[i] = norm;
+    angles[i] = angle;
+    corner[i] = c;
+    if(c >= 0) {
+      ++st.count[c];
+      st.sumNorm[c] += norm;
+      st.sumAngle[c] += angle;
+    }
+  }
+
+  double meanAngle[N_CORNERS];
+  double sqDev[N_CORNERS] = {0, 0, 0, 0};
+  double minDev[N_CORNERS];
+  for(int c = 0; c < N_CORNERS; ++c) {
+    meanAngle[c] = st.count[c] > 0 ? st.sumAngle[c] / st.count[c] : na_real();
+    minDev[c] = std::numeric_limits<double>::infinity();
+  }
+
+  for(std::size_t i = 0; i < n; ++i) {
+    int c = corner[i];
+    if(c < 0) continue;
+    double dev = angles[i] - meanAngle[c];
+    sqDev[c] += dev * dev;
+    if(std::fabs(dev) < minDev[c]) minDev[c] = std::fabs(dev);
+  }
+
+  for(int c = 0; c < N_CORNERS; ++c) {
+    // A single angle has no standard deviation, which the R implementation
+    // let through. A zero standard deviation puts every angle at the edge of
+    // the distribution.
+    if(st.count[c] == 1) {
+      st.central[c] = true;
+    } else if(st.count[c] > 1) {
+      double sd = std::sqrt(sqDev[c] / (st.count[c] - 1));
+      st.central[c] = minDev[c] < CENTRAL_HALF_Z * sd;
+    }
+  }
+}
+
+// Derives the mean vectors and corner vowels from the corner summaries.
+inline void corners_from_stats(const CornerStats& st, double f1c, double f2c,
+                               int minvectors, CornerSet& out) {
+  out.n = 0;
+  for(int c = 0; c < N_CORNERS; ++c) {
+    if(st.count[c] == 0 || !st.central[c]) continue;
+    if((long) st.count[c] <= minvectors) continue;
+
+    double norm = st.sumNorm[c] / st.count[c];
+    double angle = st.sumAngle[c] / st.count[c];
+    int k = out.n++;
+    out.which[k] = c;
+    out.norm[k] = norm;
+    out.angle[k] = angle;
+    out.f2[k] = norm * std::cos(angle) + f2c;
+    out.f1[k] = norm * std::sin(angle) + f1c;
+  }
+}
+
+// Computes vector norms, angles and corners for n vowels relative to the
+// center (f2c,f1c), and the mean vectors and corner vowels of the space.
+// norms, angles and corner must each hold n values.
+template <typename T>
+inline void vowel_space(const T& tok, std::size_t n,
+                        double f1c, double f2c, int minvectors,
+                        double* norms, double* angles, int* corner,
+                        CornerSet& out) {
+  CornerStats st;
+  corner_stats(tok, n, f1c, f2c, norms, angles, corner, st);
+  corners_from_stats(st, f1c, f2c, minvectors, out);
+}
+
+inline void vowel_space(const double* f1, const double* f2, std::size_t n,
+                        double f1c, double f2c, int minvectors,
+                        double* norms, double* angles, int* corner,
+                        CornerSet& out) {
+  vowel_space(Tokens(f1, f2), n, f1c, f2c, minvectors, norms, angles, corner,
+              out);
+}
+
+// Computes the areas of the triangles spanned by the center and each pair of
+// neighbouring mean vectors, and the vowel space area (VSA) enclosed by the
+// corner vowels. The corners are ordered by angle, so the triangles are
+// taken in that order and, for three or more corners, closed by the triangle
+// between the last and the first corner. The triangle areas are signed, and
+// their sum is the area of the corner polygon also when the center falls
+// outside of it. areas must hold N_CORNERS values. The VSA is missing when
+// there are fewer than three corners.
+inline void corner_areas(const CornerSet& cs, double* areas, int& nareas,
+                         double& vsa) {
+  nareas = 0;
+  vsa = na_real();
+  if(cs.n < 2) return;
+  int ntri = cs.n < 3 ? 1 : cs.n;
+  double total = 0;
+  for(int k = 0; k < ntri; ++k) {
+    int next = (k + 1) % cs.n;
+    double area = 0.5 * cs.norm[k] * cs.norm[next] *
+      std::sin(cs.angle[next] - cs.angle[k]);
+    areas[nareas++] = area;
+    total += area;
+  }
+  if(cs.n >= 3) vsa = std::fabs(total);
+}
+
+// Accumulates the shoelace sums of polygons whose vertices arrive one at a
+// time, in order, possibly interleaved between polygons.
+struct ShoelaceAccumulator {
+  double firstX, firstY, prevX, prevY;
+  double sum;
+  std::size_t n;
+  bool missing;
+
+  ShoelaceAccumulator() : firstX(0), firstY(0), prevX(0), prevY(0), sum(0),
+                          n(0), missing(false) {}
+
+  void add(double x, double y) {
+    if(std::isnan(x) || std::isnan(y)) {
+      missing = true;
+      return;
+    }
+    if(n == 0) {
+      firstX = x;
+      firstY = y;
+    } else {
+      sum += prevX * y - x * prevY;
+    }
+    prevX = x;
+    prevY = y;
+    ++n;
+  }
+
+  double area() const {
+    if(missing || n < 3) return na_real();
+    return std::fabs(sum + prevX * firstY - firstX * prevY) / 2;
+  }
+};
+
+} // namespace articulated
+
+#endif
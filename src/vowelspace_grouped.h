@@ -0,0 +1,63 @@
+#ifndef ARTICULATED_VOWELSPACE_GROUPED_H
+#define ARTICULATED_VOWELSPACE_GROUPED_H
+
+#include <cstddef>
+#include <vector>
+
+#include "parallel.h"
+#include "vowelspace.h"
+
+namespace articulated {
+
+// The vowel spaces of a set of groups (speakers, sessions, ...).
+struct GroupedVowelSpace {
+  std::vector<Center> centers;
+  std::vector<CornerSet> corners;
+  std::vector<double> vsa;
+};
+
+// Computes the center, corners and VSA of every group. The groups are
+// processed in parallel. Each thread gathers the formants of a group into
+// its own arena, which also holds the norms, angles and corners of the
+// group, so no memory is allocated per group once the arena has grown to fit
+// the largest group.
+inline void grouped_vowel_space(const double* f1, const double* f2,
+                                const GroupIndex& gi, CenterMethod method,
+                                int minvectors, int threads,
+                                GroupedVowelSpace& out) {
+  int ngroups = gi.ngroups();
+  out.centers.resize(ngroups);
+  out.corners.resize(ngroups);
+  out.vsa.resize(ngroups);
+
+#pragma omp parallel num_threads(threads)
+{
+  Arena arena;
+#pragma omp for schedule(dynamic)
+  for(int g = 0; g < ngroups; ++g) {
+    std::size_t n = gi.size(g);
+    arena.reset(4 * Arena::bytes_for<double>(n) + Arena::bytes_for<int>(n));
+    double* gf1 = arena.alloc<double>(n);
+    double* gf2 = arena.alloc<double>(n);
+    double* norms = arena.alloc<double>(n);
+    double* angles = arena.alloc<double>(n);
+    int* corner = arena.alloc<int>(n);
+    const std::size_t* idx = gi.index.data() + gi.offset[g];
+    for(std::size_t i = 0; i < n; ++i) {
+      gf1[i] = f1[idx[i]];
+      gf2[i] = f2[idx[i]];
+    }
+    Center& c = out.centers[g];
+    c = vowel_space_center(gf1, gf2, n, method);
+    vowel_space(gf1, gf2, n, c.f1, c.f2, minvectors, norms, angles, corner,
+                out.corners[g]);
+    double areas[N_CORNERS];
+    int nareas;
+    corner_areas(out.corners[g], areas, nareas, out.vsa[g]);
+  }
+}
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef ARTICULATED_VOWELSPACE_RCPP_H
+#define ARTICULATED_VOWELSPACE_RCPP_H
+
+#include <Rcpp.h>
+#include <string>
+
+#include "parallel.h"
+#include "vowelspace.h"
+#include "vowelspace_grouped.h"
+
+// Conversions between the native vowel space results and the R objects
+// returned by the vowel space functions.
+
+namespace articulated {
+
+inline CenterMethod center_method(const std::string& method) {
+  CenterMethod out;
+  if(!center_method_from_name(method, out)) {
+    Rcpp::stop("Unknown vowel space center method \"" + method + "\".");
+  }
+  return out;
+}
+
+inline Rcpp::CharacterVector corner_levels() {
+  Rcpp::CharacterVector levels(N_CORNERS);
+  for(int c = 0; c < N_CORNERS; ++c) {
+    levels[c] = CORNER_LABELS[c];
+  }
+  return levels;
+}
+
+// Builds the "Which vowel corner" factor for the vowels that had a corner.
+inline Rcpp::IntegerVector corner_factor(const Rcpp::IntegerVector& corner) {
+  int n = 0;
+  for(int i = 0; i < corner.size(); ++i) {
+    if(corner[i] >= 0) ++n;
+  }
+  Rcpp::IntegerVector out(n);
+  for(int i = 0, k = 0; i < corner.size(); ++i) {
+    if(corner[i] >= 0) out[k++] = corner[i] + 1;
+  }
+  out.attr("levels") = corner_levels();
+  out.attr("class") = "factor";
+  return out;
+}
+
+inline Rcpp::DataFrame corner_vowels(const CornerSet& cs) {
+  Rcpp::NumericVector f2(cs.n), f1(cs.n);
+  for(int k = 0; k < cs.n; ++k) {
+    f2[k] = cs.f2[k];
+    f1[k] = cs.f1[k];
+  }
+  return Rcpp::DataFrame::create(Rcpp::Named("f2") = f2, Rcpp::Named("f1") = f1);
+}
+
+inline Rcpp::DataFrame mean_vectors(const CornerSet& cs) {
+  Rcpp::NumericVector norm(cs.n), angle(cs.n);
+  for(int k = 0; k < cs.n; ++k) {
+    norm[k] = cs.norm[k];
+    angle[k] = cs.angle[k];
+  }
+  return Rcpp::DataFrame::create(Rcpp::Named("norm") = norm, Rcpp::Named("angle") = angle);
+}
+
+// The "Centers" and "Corner vowels" tables of vector.space.by(). Groups are
+// given by their 1-based codes.
+inline Rcpp::List grouped_vowel_space_list(const GroupIndex& gi,
+                                           const GroupedVowelSpace& vs) {
+  int ngroups = gi.ngroups();
+  Rcpp::IntegerVector cgroup(ngroups), ntokens(ngroups), ncorners(ngroups);
+  Rcpp::NumericVector cf2(ngroups), cf1(ngroups), cvsa(ngroups);
+  int nrows = 0;
+  for(int g = 0; g < ngroups; ++g) {
+    cgroup[g] = g + 1;
+    ntokens[g] = gi.size(g);
+    cf2[g] = vs.centers[g].f2;
+    cf1[g] = vs.centers[g].f1;
+    ncorners[g] = vs.corners[g].n;
+    cvsa[g] = vs.vsa[g];
+    nrows += vs.corners[g].n;
+  }
+
+  Rcpp::IntegerVector vgroup(nrows), vcorner(nrows);
+  Rcpp::NumericVector vf2(nrows), vf1(nrows), vnorm(nrows), vangle(nrows);
+  for(int g = 0, r = 0; g < ngroups; ++g) {
+    const CornerSet& cs = vs.corners[g];
+    for(int k = 0; k < cs.n; ++k, ++r) {
+      vgroup[r] = g + 1;
+      vcorner[r] = cs.which[k] + 1;
+      vf2[r] = cs.f2[k];
+      vf1[r] = cs.f1[k];
+      vnorm[r] = cs.norm[k];
+      vangle[r] = cs.angle[k];
+    }
+  }
+  vcorner.attr("levels") = corner_levels();
+  vcorner.attr("class") = "factor";
+
+  Rcpp::DataFrame centerDF = Rcpp::DataFrame::create(Rcpp::Named("group") = cgroup,
+                                         Rcpp::Named("n") = ntokens,
+                                         Rcpp::Named("f2") = cf2,
+                                         Rcpp::Named("f1") = cf1,
+                                         Rcpp::Named("corners") = ncorners,
+                                         Rcpp::Named("vsa") = cvsa);
+  Rcpp::DataFrame cornerDF = Rcpp::DataFrame::create(Rcpp::Named("group") = vgroup,
+                                         Rcpp::Named("corner") = vcorner,
+                                         Rcpp::Named("f2") = vf2,
+                                         Rcpp::Named("f1") = vf1,
+                                         Rcpp::Named("norm") = vnorm,
+                                         Rcpp::Named("angle") = vangle);
+  return Rcpp::List::create(Rcpp::Named("Centers") = centerDF,
+                      Rcpp::Named("Corner vowels") = cornerDF);
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef ARTICULATED_VOWELSPACE_STREAM_H
+#define ARTICULATED_VOWELSPACE_STREAM_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "vowelspace.h"
+
+namespace articulated {
+
+// A vowel space that is updated one vowel at a time.
+//
+// The center is kept as running sums and is updated in O(1) per vowel. The
+// vowel vectors, and so the corners and mean vectors, are measured from a
+// reference center, which is the exact center of all vowels at the last
+// rebin. Adding a vowel bins it against the reference center and updates
+// the per-corner sums in O(1).
+//
+// Rebinning policy: angles are rebinned lazily. After each vowel the running
+// center is compared with the reference center, and only when they are more
+// than 'tolerance' (in Hz, Euclidean distance in the F2/F1 plane) apart are
+// all vowels rebinned against the exact center of all vowels, which costs
+// O(n). Directly after a rebin the state matches vector.space() on all vowels
+// exactly. In between:
+//
+//  - the running "twomeans" and "wcentroid" centers assign each vowel to the
+//    F2 mean below (or above) the F1 mean as it was when the vowel arrived,
+//  - corners are reported relative to the reference center, and
+//  - a corner that did not pass the central 50% check at the last rebin
+//    passes as soon as a new vowel falls within the central 50% of the
+//    angles of the corner.
+//
+// The reference center is thus never more than the tolerance away from the
+// running center, and rebins become rare as the center settles.
+class VowelSpaceStream {
+public:
+  VowelSpaceStream(CenterMethod method, int minvectors, double tolerance)
+    : method(method), minvectors(minvectors), tolerance(tolerance),
+      nrebins(0) {
+    ref.f1 = na_real();
+    ref.f2 = na_real();
+    for(int c = 0; c < N_CORNERS; ++c) {
+      sumAngle2[c] = 0;
+    }
+  }
+
+  void add(double f1, double f2) {
+    f1s.push_back(f1);
+    f2s.push_back(f2);
+    if(!std::isnan(f1)) {
+      sumF1.add(f1, true);
+      if(!std::isnan(f2)) {
+        double f1c = sumF1.value();
+        if(f1 < f1c) low.add(f2, true);
+        else if(f1 > f1c) high.add(f2, true);
+      }
+    }
+    sumF2.add(f2, true);
+
+    Center c = center();
+    bool hasCenter = !std::isnan(c.f1) && !std::isnan(c.f2);
+    bool hasReference = !std::isnan(ref.f1) && !std::isnan(ref.f2);
+    if(hasCenter && (!hasReference ||
+       std::hypot(c.f1 - ref.f1, c.f2 - ref.f2) > tolerance)) {
+      rebin();
+    } else if(hasReference) {
+      bin(f1, f2);
+    }
+  }
+
+  // Rebins all vowels against the exact center of all vowels. If there is
+  // no exact center yet, the current binning is kept as it is.
+  void rebin() {
+    std::size_t n = f1s.size();
+    Tokens tok(f1s.data(), f2s.data());
+    Center exact = vowel_space_center(tok, n, method);
+    if(std::isnan(exact.f1) || std::isnan(exact.f2)) {
+      return;
+    }
+    ref = exact;
+
+    // Restart the running subset means from the exact partition
+    low = MeanAccumulator();
+    high = MeanAccumulator();
+    for(std::size_t i = 0; i < n; ++i) {
+      if(std::isnan(f1s[i]) || std::isnan(f2s[i])) continue;
+      if(f1s[i] < ref.f1) low.add(f2s[i], true);
+      else if(f1s[i] > ref.f1) high.add(f2s[i], true);
+    }
+
+    norms.resize(n);
+    angles.resize(n);
+    corner.resize(n);
+    corner_stats(tok, n, ref.f1, ref.f2, norms.data(), angles.data(),
+                 corner.data(), stats);
+    for(int c = 0; c < N_CORNERS; ++c) {
+      sumAngle2[c] = 0;
+    }
+    for(std::size_t i = 0; i < n; ++i) {
+      if(corner[i] >= 0) sumAngle2[corner[i]] += angles[i] * angles[i];
+    }
+    ++nrebins;
+  }
+
+  // The running center estimate.
+  Center center() const {
+    Center c;
+    c.f1 = sumF1.value();
+    switch(method) {
+    case CENTER_CENTROID:
+      c.f2 = sumF2.value();
+      break;
+    case CENTER_TWOMEANS:
+      c.f2 = (low.value() + high.value()) / 2;
+      break;
+    default:
+      c.f2 = low.value();
+    }
+    return c;
+  }
+
+  // The center that the vowel vectors are currently measured from.
+  Center reference() const {
+    return ref;
+  }
+
+  void corners(CornerSet& out) const {
+    corners_from_stats(stats, ref.f1, ref.f2, minvectors, out);
+  }
+
+  std::size_t size() const {
+    return f1s.size();
+  }
+
+  std::size_t rebins() const {
+    return nrebins;
+  }
+
+private:
+  CenterMethod method;
+  int minvectors;
+  double tolerance;
+
+  // All vowels seen so far, needed for rebinning
+  std::vector<double> f1s, f2s;
+
+  MeanAccumulator sumF1, sumF2, low, high;
+  Center ref;
+  CornerStats stats;
+  double sumAngle2[N_CORNERS];
+  std::size_t nrebins;
+
+  // Scratch buffers for rebinning, kept between rebins
+  std::vector<double> norms, angles;
+  std::vector<int> corner;
+
+  // Adds a single vowel to the corner summaries, relative to the reference
+  // center.
+  void bin(double f1, double f2) {
+    double d1 = f1 - ref.f1;
+    double d2 = f2 - ref.f2;
+    double norm = std::sqrt(d1 * d1 + d2 * d2);
+    double angle = std::atan2(d1, d2);
+    if(std::isnan(norm)) return;
+    int c = corner_of(angle);
+
+    std::size_t n = ++stats.count[c];
+    stats.sumNorm[c] += norm;
+    stats.sumAngle[c] += angle;
+    sumAngle2[c] += angle * angle;
+    if(n == 1) {
+      stats.central[c] = true;
+      return;
+    }
+    // Two angles are always equally far from their mean, so the check is
+    // exact for them. Beyond that, a corner that passed keeps passing.
+    if(n == 2) {
+      stats.central[c] = false;
+    } else if(stats.central[c]) {
+      return;
+    }
+    double mean = stats.sumAngle[c] / n;
+    double var = (sumAngle2[c] - stats.sumAngle[c] * mean) / (n - 1);
+    double sd = var > 0 ? std::sqrt(var) : 0;
+    stats.central[c] = std::fabs(angle - mean) < CENTRAL_HALF_Z * sd;
+  }
+};
+
+} // namespace articulated
+
+#endif
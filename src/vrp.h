@@ -0,0 +1,123 @@
+#ifndef ARTICULATED_VRP_H
+#define ARTICULATED_VRP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Voice range profiles (VRP): counts of voiced frames in a grid of pitch
+// (semitone) by level (dB) bins.
+
+namespace articulated {
+
+// A dense 2-D histogram. Bin (i, j) holds the frames whose values round to
+// (x0 + i) * binx and (y0 + j) * biny, and its count is
+// counts[j * nx + i].
+struct Histogram2 {
+  double binx, biny;
+  long x0, y0;
+  long nx, ny;
+  std::vector<int> counts;
+};
+
+// The bin index of a value: round(v / bin), rounding halves to even as
+// round() in R does.
+inline long bin_index(double v, double bin) {
+  return (long) std::nearbyint(v / bin);
+}
+
+// Bins the frames (x[i], y[i]) into a histogram with bins of binx by biny.
+// Frames with a missing (unvoiced or silent) value are skipped. The grid
+// spans exactly the occupied bins: a first pass finds their range, and the
+// second maps every frame to its flat grid index and counts it.
+inline void histogram2(const double* x, const double* y, std::size_t n,
+                       double binx, double biny, Histogram2& out) {
+  out.binx = binx;
+  out.biny = biny;
+  long xmin = 0, xmax = -1, ymin = 0, ymax = -1;
+  bool any = false;
+  for(std::size_t i = 0; i < n; ++i) {
+    if(std::isnan(x[i]) || std::isnan(y[i]) || std::isinf(x[i]) ||
+       std::isinf(y[i])) continue;
+    long bx = bin_index(x[i], binx), by = bin_index(y[i], biny);
+    if(!any) {
+      xmin = xmax = bx;
+      ymin = ymax = by;
+      any = true;
+    } else {
+      if(bx < xmin) xmin = bx;
+      if(bx > xmax) xmax = bx;
+      if(by < ymin) ymin = by;
+      if(by > ymax) ymax = by;
+    }
+  }
+  out.x0 = xmin;
+  out.y0 = ymin;
+  out.nx = xmax - xmin + 1;
+  out.ny = ymax - ymin + 1;
+  out.counts.assign((std::size_t) out.nx * out.ny, 0);
+  if(!any) return;
+  for(std::size_t i = 0; i < n; ++i) {
+    if(std::isnan(x[i]) || std::isnan(y[i]) || std::isinf(x[i]) ||
+       std::isinf(y[i])) continue;
+    long bx = bin_index(x[i], binx) - xmin, by = bin_index(y[i], biny) - ymin;
+    ++out.counts[(std::size_t) by * out.nx + bx];
+  }
+}
+
+// Counts one frame into a histogram, growing its grid if the frame falls
+// outside it. The histogram may start out empty (nx = ny = 0). Frames with
+// a missing value are skipped.
+inline void histogram2_add(Histogram2& h, double x, double y) {
+  if(std::isnan(x) || std::isnan(y) || std::isinf(x) || std::isinf(y)) return;
+  long bx = bin_index(x, h.binx), by = bin_index(y, h.biny);
+  if(h.nx == 0 || h.ny == 0) {
+    h.x0 = bx;
+    h.y0 = by;
+    h.nx = h.ny = 1;
+    h.counts.assign(1, 0);
+  } else if(bx < h.x0 || bx >= h.x0 + h.nx || by < h.y0 || by >= h.y0 + h.ny) {
+    long x0 = std::min(bx, h.x0), y0 = std::min(by, h.y0);
+    long nx = std::max(bx, h.x0 + h.nx - 1) - x0 + 1;
+    long ny = std::max(by, h.y0 + h.ny - 1) - y0 + 1;
+    std::vector<int> counts((std::size_t) nx * ny, 0);
+    for(long j = 0; j < h.ny; ++j) {
+      for(long i = 0; i < h.nx; ++i) {
+        counts[(std::size_t) (h.y0 + j - y0) * nx + (h.x0 + i - x0)] =
+          h.counts[(std::size_t) j * h.nx + i];
+      }
+    }
+    h.x0 = x0;
+    h.y0 = y0;
+    h.nx = nx;
+    h.ny = ny;
+    h.counts.swap(counts);
+  }
+  ++h.counts[(std::size_t) (by - h.y0) * h.nx + (bx - h.x0)];
+}
+
+// The number of non-empty bins of a histogram
+inline std::size_t occupied(const Histogram2& h) {
+  std::size_t out = 0;
+  for(std::size_t k = 0; k < h.counts.size(); ++k) {
+    if(h.counts[k] > 0) ++out;
+  }
+  return out;
+}
+
+// Calls f(x, y, count) for every non-empty bin of a histogram, with the
+// values of the bin, in order of y and then x.
+template <typename F>
+void for_each_bin(const Histogram2& h, F f) {
+  for(long j = 0; j < h.ny; ++j) {
+    for(long i = 0; i < h.nx; ++i) {
+      int c = h.counts[(std::size_t) j * h.nx + i];
+      if(c > 0) f((h.x0 + i) * h.binx, (h.y0 + j) * h.biny, c);
+    }
+  }
+}
+
+} // namespace articulated
+
+#endif
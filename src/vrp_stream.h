@@ -0,0 +1,111 @@
+#ifndef ARTICULATED_VRP_STREAM_H
+#define ARTICULATED_VRP_STREAM_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "voice.h"
+#include "vrp.h"
+
+// A voice range profile computed as a stream, for recordings too long to
+// hold in memory as a sound or as F0 and RMS tracks.
+//
+// Blocks of samples are added as they come. Every frame of the grid that
+// is complete after a block is analysed for F0 and RMS level and counted
+// into the (pitch, level) histogram right away; only the samples still
+// needed by the next frame are kept. Memory use is thus bounded by the
+// block size, the frame span and the range of the histogram, and does not
+// depend on the length of the recording. The histogram may be read at any
+// time, as the profile of the sound added so far. The frames analysed are
+// those of voice_track() on the whole sound, so the final profile equals
+// the one computed from the complete tracks. Levels are counted in dB re
+// full scale plus 'fullscale', the level given to full scale.
+
+namespace articulated {
+
+class VRPStream {
+public:
+  VRPStream(double rate, double minf, double maxf, double shift,
+            double window, double threshold, double stbin, double dbbin,
+            double fullscale)
+    : yin(rate, minf, maxf, threshold),
+      window(std::max<std::size_t>(1, (std::size_t) (window * rate + 0.5))),
+      grid(voice_grid(rate, shift, yin, this->window)),
+      fullscale(fullscale), base(0), next(0), samples(0), nvoiced(0) {
+    hist.binx = stbin;
+    hist.biny = dbbin;
+    hist.x0 = hist.y0 = 0;
+    hist.nx = hist.ny = 0;
+  }
+
+  // Adds n samples and analyses the frames they complete.
+  void add(const double* x, std::size_t n, int threads) {
+    buffer.insert(buffer.end(), x, x + n);
+    samples += n;
+    std::size_t last = grid.frames(samples);
+    if(last > next) {
+      std::size_t count = last - next;
+      f0.resize(count);
+      voicing.resize(count);
+      semitones.resize(count);
+      rms.resize(count);
+      VoiceTracks out = {f0.data(), voicing.data(), semitones.data(),
+                         rms.data()};
+      voice_track_range(buffer.data(), base, grid, yin, window, next, count,
+                        threads, out);
+      for(std::size_t k = 0; k < count; ++k) {
+        if(std::isnan(semitones[k]) || std::isnan(rms[k])) continue;
+        histogram2_add(hist, semitones[k], rms[k] + fullscale);
+        ++nvoiced;
+      }
+      next = last;
+    }
+    // Drop the samples before the first frame not yet analysed
+    std::size_t drop = std::min(grid.start(next), samples) - base;
+    if(drop > 0) {
+      buffer.erase(buffer.begin(), buffer.begin() + drop);
+      base += drop;
+    }
+  }
+
+  double rate() const {
+    return grid.rate;
+  }
+
+  // The number of samples added
+  std::size_t length() const {
+    return samples;
+  }
+
+  // The number of frames analysed
+  std::size_t frames() const {
+    return next;
+  }
+
+  // The number of frames counted in the profile (voiced, with a level)
+  std::size_t voiced() const {
+    return nvoiced;
+  }
+
+  // The profile of the frames analysed so far
+  const Histogram2& profile() const {
+    return hist;
+  }
+
+private:
+  Yin yin;
+  std::size_t window;
+  FrameGrid grid;
+  double fullscale;
+  // The samples from sample 'base' on that later frames still need
+  std::vector<double> buffer;
+  std::size_t base, next, samples, nvoiced;
+  std::vector<double> f0, voicing, semitones, rms;
+  Histogram2 hist;
+};
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,257 @@
+#include <Rcpp.h>
+#include "hull.h"
+#include "parallel.h"
+#include "vsd.h"
+#include "vsd_grouped.h"
+#include "vsd_rcpp.h"
+#include "vsd_stream.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+using namespace Rcpp;
+
+using namespace articulated;
+
+// Native backend of VSD(). Normalises the formants by their medians, computes
+// the density over the grid seq(-1 + gridres/2, 1.5, gridres) in both
+// dimensions, and returns the coordinates of the grid points whose density
+// is at least 'threshold' times the maximum density, in the order of
+// expand.grid(F1=grid,F2=grid).
+// [[Rcpp::export]]
+DataFrame cppVSD(NumericVector f2,
+                 NumericVector f1,
+                 double resolution = 0.05,
+                 double gridres = 0.01,
+                 double threshold = 0.25,
+                 std::string method = "count") {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  if(!(gridres > 0)) {
+    Rcpp::stop("The grid resolution must be positive.");
+  }
+  bool smooth;
+  DensityKernel kernel;
+  vsd_method(method, resolution, smooth, kernel);
+  std::size_t n = f2.size();
+  std::vector<double> scratch, f2n, f1n;
+  double f2med, f1med;
+  vsd_normalise(f2.begin(), f1.begin(), n, scratch, f2n, f1n, f2med, f1med);
+
+  UniformGrid g(-1 + gridres / 2, 1.5, gridres);
+  int m = g.m;
+  std::size_t ng = (std::size_t) m * m;
+  std::vector<double> density(ng);
+  if(smooth) {
+    vsd_density(f2n.data(), f1n.data(), n, g, m, resolution, kernel,
+                density.data());
+  } else {
+    std::vector<int> counts(ng);
+    vsd_counts(f2n.data(), f1n.data(), n, g, m, resolution, counts.data());
+    density.assign(counts.begin(), counts.end());
+  }
+  double maxDensity = 0;
+  for(std::size_t k = 0; k < ng; ++k) {
+    if(density[k] > maxDensity) maxDensity = density[k];
+  }
+
+  std::vector<double> pf2, pf1;
+  for(std::size_t k = 0; k < ng; ++k) {
+    if(density[k] / maxDensity >= threshold) {
+      pf2.push_back(g[k / m]);
+      pf1.push_back(g[k % m]);
+    }
+  }
+  return DataFrame::create(Named("F2") = NumericVector(pf2.begin(), pf2.end()),
+                           Named("F1") = NumericVector(pf1.begin(), pf1.end()));
+}
+
+// Native backend of VSD.sweep(). Normalises the formants by their medians
+// as cppVSD() does, and indexes the frames once for all grids. For each
+// grid seq(-1 + gridres/2, 1.5, gridres), the frames within each of the
+// (ascending) radii of every grid point are counted in a single visit of
+// the point, and the counts are thresholded at every density threshold.
+// Returns one row per grid resolution, radius and threshold, in that
+// nesting order, with the number of cells kept and the area of their hull
+// (NA when no cell is kept, and zero when the cells span no polygon, as in
+// VSD()).
+// [[Rcpp::export]]
+DataFrame cppVSDSweep(NumericVector f2,
+                      NumericVector f1,
+                      NumericVector gridres,
+                      NumericVector radii,
+                      NumericVector thresholds) {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  int nr = radii.size(), ng = gridres.size(), nt = thresholds.size();
+  for(int k = 1; k < nr; ++k) {
+    if(!(radii[k] > radii[k - 1])) {
+      Rcpp::stop("The radii must be sorted in increasing order.");
+    }
+  }
+  for(int s = 0; s < ng; ++s) {
+    if(!(gridres[s] > 0 && gridres[s] < 2.5)) {
+      Rcpp::stop("The grid resolutions must be positive and below 2.5.");
+    }
+  }
+  std::size_t n = f2.size();
+  std::vector<double> scratch, f2n, f1n;
+  double f2med, f1med;
+  vsd_normalise(f2.begin(), f1.begin(), n, scratch, f2n, f1n, f2med, f1med);
+
+  std::size_t nrows = (std::size_t) ng * nr * nt;
+  NumericVector vres(nrows), vgrid(nrows), vthr(nrows), varea(nrows);
+  IntegerVector vcells(nrows);
+  if(nrows == 0) {
+    return DataFrame::create(Named("resolution") = vres,
+                             Named("grid.res") = vgrid,
+                             Named("density.threshold") = vthr,
+                             Named("cells") = vcells,
+                             Named("area") = varea);
+  }
+
+  // One index for all grids, with buckets for the finest of them
+  int mmax = 1;
+  double hi = 1.5;
+  for(int s = 0; s < ng; ++s) {
+    mmax = std::max(mmax, UniformGrid(-1 + gridres[s] / 2, hi, gridres[s]).m);
+  }
+  PointGrid index;
+  vsd_point_grid(f2n.data(), f1n.data(), n, -1, hi, mmax, radii[nr - 1],
+                 index);
+
+  std::vector<double> g, px, py;
+  std::vector<int> counts;
+  std::vector<std::size_t> order;
+  Hull hull;
+  std::size_t row = 0;
+  for(int s = 0; s < ng; ++s) {
+    UniformGrid ug(-1 + gridres[s] / 2, hi, gridres[s]);
+    int m = ug.m;
+    std::size_t cells = (std::size_t) m * m;
+    g.resize(m);
+    for(int i = 0; i < m; ++i) {
+      g[i] = ug[i];
+    }
+    counts.resize(cells * nr);
+    vsd_count_sweep(index, g.data(), m, radii.begin(), nr, counts.data());
+    for(int r = 0; r < nr; ++r) {
+      const int* c = counts.data() + r * cells;
+      int maxCount = *std::max_element(c, c + cells);
+      for(int t = 0; t < nt; ++t) {
+        px.clear();
+        py.clear();
+        if(maxCount > 0) {
+          for(std::size_t k = 0; k < cells; ++k) {
+            if((double) c[k] / maxCount >= thresholds[t]) {
+              px.push_back(g[k / m]);
+              py.push_back(g[k % m]);
+            }
+          }
+        }
+        vres[row] = radii[r];
+        vgrid[row] = gridres[s];
+        vthr[row] = thresholds[t];
+        vcells[row] = px.size();
+        if(!px.empty()) {
+          convex_hull(px.data(), py.data(), px.size(), order, hull);
+          varea[row] = hull.area;
+        } else {
+          varea[row] = R_NaReal;
+        }
+        ++row;
+      }
+    }
+  }
+  return DataFrame::create(Named("resolution") = vres,
+                           Named("grid.res") = vgrid,
+                           Named("density.threshold") = vthr,
+                           Named("cells") = vcells,
+                           Named("area") = varea);
+}
+
+// Native backend of VSD.by(). The tokens are split by group once, and the
+// VSD of each group is computed in parallel. Returns a table with the
+// number of retained grid cells and the hull area and perimeter of each
+// group, and a table of the hull vertices, given as 1-based grid point
+// indices and coordinates. Groups are given by their 1-based codes.
+// [[Rcpp::export]]
+List cppGroupedVSD(NumericVector f2,
+                   NumericVector f1,
+                   IntegerVector group,
+                   int ngroups,
+                   NumericVector grid,
+                   double resolution,
+                   double threshold,
+                   std::string method = "count",
+                   int threads = 0) {
+  if(f1.size() != f2.size() || f1.size() != group.size()) {
+    Rcpp::stop("The F1, F2 and group vectors must be of the same length.");
+  }
+  bool smooth;
+  DensityKernel kernel;
+  vsd_method(method, resolution, smooth, kernel);
+  GroupIndex gi(group.begin(), group.size(), ngroups);
+  std::vector<GroupVSD> vsd;
+  int m = grid.size();
+  grouped_vsd(f1.begin(), f2.begin(), gi, grid.begin(), m, resolution,
+              threshold, smooth, kernel, resolve_threads(threads), vsd);
+
+  return grouped_vsd_list(gi, vsd, grid.begin(), m);
+}
+
+// Native backend of VSD.stream(). The grid must be in increasing order.
+// [[Rcpp::export]]
+SEXP cppVSDStreamNew(NumericVector grid,
+                     double resolution = 0.05,
+                     double threshold = 0.25,
+                     double tolerance = 0.01) {
+  std::vector<double> g(grid.begin(), grid.end());
+  XPtr<VSDStream> ptr(new VSDStream(g, resolution, threshold, tolerance), true);
+  return ptr;
+}
+
+// [[Rcpp::export]]
+void cppVSDStreamAdd(SEXP stream, NumericVector f2, NumericVector f1) {
+  if(f1.size() != f2.size()) {
+    Rcpp::stop("The F1 and F2 vectors must be of the same length.");
+  }
+  XPtr<VSDStream> vsd(stream);
+  for(int i = 0; i < f2.size(); ++i) {
+    vsd->add(f2[i], f1[i]);
+  }
+}
+
+// [[Rcpp::export]]
+List cppVSDStreamState(SEXP stream, bool recompute = false) {
+  XPtr<VSDStream> vsd(stream);
+  if(recompute) {
+    vsd->recompute();
+  }
+  std::size_t ncells;
+  const Hull& h = vsd->hull(ncells);
+  int m = vsd->gridSize();
+  std::size_t nv = h.vertices.size();
+  IntegerVector hcell(nv);
+  NumericVector hf2(nv), hf1(nv);
+  for(std::size_t v = 0; v < nv; ++v) {
+    std::size_t k = vsd->cell(h.vertices[v]);
+    hcell[v] = k + 1;
+    hf2[v] = vsd->grid(k / m);
+    hf1[v] = vsd->grid(k % m);
+  }
+  bool empty = ncells == 0;
+  return List::create(Named("area") = empty ? R_NaReal : h.area,
+                      Named("perimeter") = empty ? R_NaReal : h.perimeter,
+                      Named("cells") = (int) ncells,
+                      Named("Hull") = DataFrame::create(Named("cell") = hcell,
+                                                        Named("F2") = hf2,
+                                                        Named("F1") = hf1),
+                      Named("Medians") = NumericVector::create(Named("F2") = vsd->median2(),
+                                                               Named("F1") = vsd->median1()),
+                      Named("Reference medians") = NumericVector::create(Named("F2") = vsd->reference2(),
+                                                                         Named("F1") = vsd->reference1()),
+                      Named("Frames") = (int) vsd->size(),
+                      Named("Recomputes") = (int) vsd->recomputes());
+}
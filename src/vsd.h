@@ -0,0 +1,396 @@
+#ifndef ARTICULATED_VSD_H
+#define ARTICULATED_VSD_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "vowelspace.h"
+
+// Kernels for the vowel space density (VSD) of Story & Bunton (2017). The
+// density at a grid point is the number of (normalised) formant frames
+// within 'resolution' of it, or, in the smooth variant, a kernel density
+// estimate with bandwidth 'resolution'.
+//
+// The grid points are the centers of a square grid whose coordinates along
+// both axes are given by g[0] .. g[m - 1], in increasing order, so that grid
+// point k has F1 = g[k % m] and F2 = g[k / m] (the order of
+// expand.grid(F1=g,F2=g)). The kernels take the coordinates either as a
+// vector or as a UniformGrid, which computes them from their index.
+
+namespace articulated {
+
+// The coordinates of seq(from, to, by) for by > 0, computed from their
+// index exactly as seq() computes them, without storing them.
+struct UniformGrid {
+  double from, to, by;
+  int m;
+
+  UniformGrid(double from, double to, double by) : from(from), to(to), by(by) {
+    double n = (to - from) / by;
+    m = n >= 0 ? (int) (n + 1e-10) + 1 : 0;
+  }
+
+  double operator[](int k) const {
+    return std::min(from + k * by, to);
+  }
+};
+
+// The median of the non-missing values among x[0] .. x[n - 1], as computed
+// by median(x, na.rm=TRUE). The values are reordered. The middle pair of an
+// even number of values is averaged like mean() does, in extended precision
+// and with mean()'s correction step, so the result is identical to R's.
+inline double median_inplace(double* x, std::size_t n) {
+  double* end = std::remove_if(x, x + n, [](double v) { return std::isnan(v); });
+  std::size_t m = end - x;
+  if(m == 0) return na_real();
+  std::size_t half = (m + 1) / 2;
+  std::nth_element(x, x + half - 1, end);
+  double a = x[half - 1];
+  if(m % 2 == 1) return a;
+  double b = *std::min_element(x + half, end);
+  long double s = ((long double) a + b) / 2;
+  if(std::isfinite((double) s)) {
+    long double t = (a - s) + (b - s);
+    s += t / 2;
+  }
+  return (double) s;
+}
+
+// Normalises formants by their medians, (F - median) / median, as VSD()
+// does. Both medians are found by selection on a single scratch copy, and
+// the normalised values are written in one fused pass into the
+// struct-of-arrays buffers f2n and f1n.
+inline void vsd_normalise(const double* f2, const double* f1, std::size_t n,
+                          std::vector<double>& scratch,
+                          std::vector<double>& f2n, std::vector<double>& f1n,
+                          double& f2med, double& f1med) {
+  scratch.assign(f1, f1 + n);
+  f1med = median_inplace(scratch.data(), n);
+  scratch.assign(f2, f2 + n);
+  f2med = median_inplace(scratch.data(), n);
+  f2n.resize(n);
+  f1n.resize(n);
+  for(std::size_t i = 0; i < n; ++i) {
+    f2n[i] = (f2[i] - f2med) / f2med;
+    f1n[i] = (f1[i] - f1med) / f1med;
+  }
+}
+
+// A uniform hash grid over points in the plane. The points are sorted into
+// square buckets of side 'cell', stored contiguously bucket by bucket, so
+// that the points near a location can be visited by scanning a few short
+// runs of memory. Points beyond the edge of the bucket range are put in the
+// outermost buckets; they are still tested against every query, so they
+// cost time but never change a result. Points with a missing coordinate are
+// dropped.
+class PointGrid {
+public:
+  PointGrid() : x0(0), y0(0), cell(1), nx(1), ny(1) {}
+
+  PointGrid(const double* x, const double* y, std::size_t n,
+            double x0, double y0, double cell, int nx, int ny) {
+    build(x, y, n, x0, y0, cell, nx, ny);
+  }
+
+  // Sorts the points into the buckets. The storage of an earlier build is
+  // reused, so rebuilding a grid for the next set of points does not
+  // allocate unless the new set is larger.
+  void build(const double* x, const double* y, std::size_t n,
+             double x0, double y0, double cell, int nx, int ny) {
+    this->x0 = x0;
+    this->y0 = y0;
+    this->cell = cell;
+    this->nx = nx;
+    this->ny = ny;
+    offset.assign((std::size_t) nx * ny + 1, 0);
+    bucket.resize(n);
+    for(std::size_t i = 0; i < n; ++i) {
+      if(std::isnan(x[i]) || std::isnan(y[i])) {
+        bucket[i] = -1;
+        continue;
+      }
+      bucket[i] = column(x[i]) * ny + row(y[i]);
+      ++offset[bucket[i] + 1];
+    }
+    for(std::size_t b = 1; b < offset.size(); ++b) {
+      offset[b] += offset[b - 1];
+    }
+    px.resize(offset.back());
+    py.resize(offset.back());
+    pos.assign(offset.begin(), offset.end() - 1);
+    for(std::size_t i = 0; i < n; ++i) {
+      if(bucket[i] < 0) continue;
+      std::size_t k = pos[bucket[i]]++;
+      px[k] = x[i];
+      py[k] = y[i];
+    }
+  }
+
+  // The bucket column and row of a coordinate, clamped to the grid.
+  int column(double x) const {
+    return clamp(std::floor((x - x0) / cell), nx);
+  }
+
+  int row(double y) const {
+    return clamp(std::floor((y - y0) / cell), ny);
+  }
+
+  // Calls f(d) with the distance d to (x,y) of every point in the buckets
+  // that may hold points within distance r of (x,y). The distance is
+  // computed as sqrt(dx^2 + dy^2), which gives the same values as a
+  // Euclidean distance matrix.
+  template <typename F>
+  void for_each_near(double x, double y, double r, F& f) const {
+    // The bucket range is widened by a relative margin so that rounding in
+    // the bucket arithmetic can never exclude a point on the boundary.
+    double margin = r * (1 + 1e-9) + 1e-12;
+    int c0 = column(x - margin), c1 = column(x + margin);
+    int r0 = row(y - margin), r1 = row(y + margin);
+    for(int c = c0; c <= c1; ++c) {
+      std::size_t from = offset[(std::size_t) c * ny + r0];
+      std::size_t to = offset[(std::size_t) c * ny + r1 + 1];
+      for(std::size_t k = from; k < to; ++k) {
+        double dx = px[k] - x;
+        double dy = py[k] - y;
+        f(std::sqrt(dx * dx + dy * dy));
+      }
+    }
+  }
+
+  // Counts the points within (at most) distance r of (x,y).
+  std::size_t count_within(double x, double y, double r) const {
+    RadiusCount count = {r, 0};
+    for_each_near(x, y, r, count);
+    return count.n;
+  }
+
+  std::size_t size() const {
+    return px.size();
+  }
+
+private:
+  struct RadiusCount {
+    double r;
+    std::size_t n;
+    void operator()(double d) { if(d <= r) ++n; }
+  };
+
+  double x0, y0, cell;
+  int nx, ny;
+  // Points of bucket b (column c, row r, b = c * ny + r) are stored in
+  // offset[b] .. offset[b + 1] - 1, so a column of buckets is contiguous.
+  std::vector<std::size_t> offset;
+  std::vector<double> px, py;
+  // Scratch space for building
+  std::vector<int> bucket;
+  std::vector<std::size_t> pos;
+
+  static int clamp(double v, int n) {
+    if(!(v >= 0)) return 0;
+    if(v >= n - 1) return n - 1;
+    return (int) v;
+  }
+};
+
+// Builds the bucket grid for counting within 'radius' of the grid points
+// in [lo, hi] along both axes, with m grid coordinates along each axis.
+// Buckets have the side of the counting radius, but are never smaller than
+// the grid spacing, so that there are O(m^2) of them.
+inline void vsd_point_grid(const double* f2, const double* f1, std::size_t n,
+                           double lo, double hi, int m, double radius,
+                           PointGrid& out) {
+  lo -= radius;
+  hi += radius;
+  double cell = std::max(radius, (hi - lo) / m);
+  if(!(cell > 0)) cell = 1;
+  int nb = std::max(1, (int) std::ceil((hi - lo) / cell) + 1);
+  out.build(f2, f1, n, lo, lo, cell, nb, nb);
+}
+
+// Computes the number of points within 'resolution' of every grid point. The
+// points are (f2[i], f1[i]), and the grid has m coordinates g along each
+// axis. counts must hold m * m values. Memory use is O(n + m^2), and the
+// time is proportional to the number of grid points times the number of
+// points in the few buckets around each of them.
+template <typename G>
+inline void vsd_counts(const double* f2, const double* f1, std::size_t n,
+                       const G& g, int m, double resolution, int* counts) {
+  if(m <= 0) return;
+  PointGrid grid;
+  vsd_point_grid(f2, f1, n, g[0], g[m - 1], m, resolution, grid);
+
+  for(int j = 0; j < m; ++j) {
+    for(int i = 0; i < m; ++i) {
+      counts[(std::size_t) j * m + i] = grid.count_within(g[j], g[i], resolution);
+    }
+  }
+}
+
+// Accumulates, for one grid point, how many points fall within each of a
+// set of ascending radii. Every candidate distance is compared once and
+// tallied at the smallest radius that includes it; the counts for all radii
+// then follow as cumulative sums.
+struct RadiusHistogram {
+  const double* radii;
+  int nr;
+  int* tally;
+
+  void operator()(double d) {
+    if(!(d <= radii[nr - 1])) return;
+    int k = (int) (std::lower_bound(radii, radii + nr, d) - radii);
+    ++tally[k];
+  }
+};
+
+// Counts the points within each of nr ascending radii of every grid point,
+// using a bucket grid built for the largest radius (see vsd_point_grid()).
+// Each grid point is visited once whatever the number of radii. counts must
+// hold m * m * nr values, with the counts for radius k in
+// counts[k * m * m] .. counts[(k + 1) * m * m - 1].
+inline void vsd_count_sweep(const PointGrid& grid, const double* g, int m,
+                            const double* radii, int nr, int* counts) {
+  if(m <= 0 || nr <= 0) return;
+  std::size_t ng = (std::size_t) m * m;
+  std::vector<int> tally(nr);
+  RadiusHistogram hist = {radii, nr, tally.data()};
+  for(int j = 0; j < m; ++j) {
+    for(int i = 0; i < m; ++i) {
+      std::fill(tally.begin(), tally.end(), 0);
+      grid.for_each_near(g[j], g[i], radii[nr - 1], hist);
+      std::size_t cellIndex = (std::size_t) j * m + i;
+      int total = 0;
+      for(int k = 0; k < nr; ++k) {
+        total += tally[k];
+        counts[k * ng + cellIndex] = total;
+      }
+    }
+  }
+}
+
+enum DensityKernel {
+  KERNEL_GAUSSIAN,      // standard deviation = bandwidth
+  KERNEL_EPANECHNIKOV   // support = bandwidth
+};
+
+inline bool density_kernel_from_name(const std::string& name,
+                                     DensityKernel& kernel) {
+  if(name == "gaussian") kernel = KERNEL_GAUSSIAN;
+  else if(name == "epanechnikov") kernel = KERNEL_EPANECHNIKOV;
+  else return false;
+  return true;
+}
+
+// The weights of a kernel sampled at multiples of 'step', for offsets
+// -w .. w, with w >= 1. Returns the 2w + 1 weights, scaled to sum to 1.
+inline std::vector<double> kernel_weights(DensityKernel kernel,
+                                          double bandwidth, double step,
+                                          int& w) {
+  double support = kernel == KERNEL_GAUSSIAN ? 4 * bandwidth : bandwidth;
+  w = std::max(1, (int) std::ceil(support / step));
+  std::vector<double> out(2 * w + 1);
+  double sum = 0;
+  for(int k = -w; k <= w; ++k) {
+    double t = k * step / bandwidth;
+    double v = kernel == KERNEL_GAUSSIAN ? std::exp(-0.5 * t * t)
+                                         : std::max(0.0, 1 - t * t);
+    out[k + w] = v;
+    sum += v;
+  }
+  for(std::size_t k = 0; k < out.size(); ++k) {
+    out[k] /= sum;
+  }
+  return out;
+}
+
+// Convolves the lines of a column major nr x nc matrix with a kernel
+// (along the rows when 'down' is true, otherwise along the columns).
+inline void convolve_lines(const double* in, int nr, int nc, bool down,
+                           const std::vector<double>& kern, int w,
+                           double* out) {
+  int len = down ? nr : nc;
+  int nlines = down ? nc : nr;
+  std::size_t stride = down ? 1 : nr;
+  for(int l = 0; l < nlines; ++l) {
+    const double* src = in + (down ? (std::size_t) l * nr : l);
+    double* dst = out + (down ? (std::size_t) l * nr : l);
+    for(int i = 0; i < len; ++i) {
+      int k0 = std::max(-w, -i), k1 = std::min(w, len - 1 - i);
+      double acc = 0;
+      for(int k = k0; k <= k1; ++k) {
+        acc += kern[k + w] * src[(i + k) * stride];
+      }
+      dst[i * stride] = acc;
+    }
+  }
+}
+
+// Computes a kernel density estimate at every grid point, for points
+// (f2[i], f1[i]) and a uniformly spaced grid of m coordinates g along each
+// axis. density must hold m * m values, in the order of vsd_counts().
+//
+// The points are linearly binned onto the grid nodes, after which the
+// binned counts are smoothed by a product kernel, one separable 1-D pass
+// along each axis. The cost is O(n + m^2 w) for a kernel reaching w grid
+// steps, independent of the number of points beyond the binning. The grid
+// is padded by w nodes on every side while smoothing, so that points just
+// outside of it still contribute. The estimate is scaled to a density per
+// unit area.
+//
+// bins and tmp are scratch space, which is reused between calls.
+template <typename G>
+inline void vsd_density(const double* f2, const double* f1, std::size_t n,
+                        const G& g, int m, double bandwidth,
+                        DensityKernel kernel, double* density,
+                        std::vector<double>& bins, std::vector<double>& tmp) {
+  if(m <= 0) return;
+  double step = m > 1 ? (g[m - 1] - g[0]) / (m - 1) : bandwidth;
+  if(!(step > 0)) step = 1;
+  int w;
+  std::vector<double> kern = kernel_weights(kernel, bandwidth, step, w);
+  int mp = m + 2 * w;
+  bins.assign((std::size_t) mp * mp, 0.0);
+  tmp.resize((std::size_t) mp * mp);
+
+  std::size_t used = 0;
+  for(std::size_t p = 0; p < n; ++p) {
+    // Grid coordinates, with F1 along the rows and F2 along the columns
+    double u = (f1[p] - g[0]) / step + w;
+    double v = (f2[p] - g[0]) / step + w;
+    if(std::isnan(u) || std::isnan(v)) continue;
+    ++used;
+    if(u < 0 || v < 0 || u > mp - 1 || v > mp - 1) continue;
+    int i = std::min((int) u, mp - 2);
+    int j = std::min((int) v, mp - 2);
+    double du = u - i, dv = v - j;
+    bins[(std::size_t) j * mp + i] += (1 - du) * (1 - dv);
+    bins[(std::size_t) j * mp + i + 1] += du * (1 - dv);
+    bins[(std::size_t) (j + 1) * mp + i] += (1 - du) * dv;
+    bins[(std::size_t) (j + 1) * mp + i + 1] += du * dv;
+  }
+
+  convolve_lines(bins.data(), mp, mp, true, kern, w, tmp.data());
+  convolve_lines(tmp.data(), mp, mp, false, kern, w, bins.data());
+
+  double scale = used > 0 ? 1 / (used * step * step) : 0;
+  for(int j = 0; j < m; ++j) {
+    for(int i = 0; i < m; ++i) {
+      density[(std::size_t) j * m + i] =
+        bins[(std::size_t) (j + w) * mp + i + w] * scale;
+    }
+  }
+}
+
+template <typename G>
+inline void vsd_density(const double* f2, const double* f1, std::size_t n,
+                        const G& g, int m, double bandwidth,
+                        DensityKernel kernel, double* density) {
+  std::vector<double> bins, tmp;
+  vsd_density(f2, f1, n, g, m, bandwidth, kernel, density, bins, tmp);
+}
+
+} // namespace articulated
+
+#endif
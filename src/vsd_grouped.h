@@ -0,0 +1,149 @@
+#ifndef ARTICULATED_VSD_GROUPED_H
+#define ARTICULATED_VSD_GROUPED_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "hull.h"
+#include "parallel.h"
+#include "vowelspace.h"
+#include "vsd.h"
+
+namespace articulated {
+
+// The VSD of a group: the number of grid cells retained after thresholding,
+// and the convex hull around them, with the hull vertices given as grid
+// point indices (see vsd.h for the order of the grid points).
+struct GroupVSD {
+  std::size_t cells;
+  double area;
+  double perimeter;
+  std::vector<std::size_t> hull;
+};
+
+// Scratch memory for computing the VSD of one set of tokens: an arena for
+// the normalised formants, the bucket grid, the density grid and the hull
+// buffers. A workspace is reused from one set to the next, so that only
+// the first set allocates.
+struct VSDWorkspace {
+  Arena arena;
+  PointGrid index;
+  std::vector<double> density;
+  std::vector<int> counts;
+  std::vector<double> bins, tmp, hx, hy;
+  std::vector<std::size_t> cell, order;
+  Hull hull;
+};
+
+// Computes the VSD of the n tokens listed in idx, for a grid of m
+// coordinates g in [lo, hi] along each axis. The formants are normalised by
+// the medians of these tokens, as in VSD(). With density counting (smooth =
+// false) the vowels within 'resolution' of each grid point are counted;
+// otherwise a kernel density estimate with bandwidth 'resolution' is used.
+// A set without retained cells has a missing area and perimeter.
+inline void vsd_of_tokens(const double* f1, const double* f2,
+                          const std::size_t* idx, std::size_t n,
+                          const double* g, int m, double lo, double hi,
+                          double resolution, double threshold, bool smooth,
+                          DensityKernel kernel, VSDWorkspace& ws,
+                          GroupVSD& res) {
+  std::size_t ng = (std::size_t) m * m;
+  ws.density.resize(ng);
+  if(!smooth) ws.counts.resize(ng);
+  ws.arena.reset(3 * Arena::bytes_for<double>(n));
+  double* n1 = ws.arena.alloc<double>(n);
+  double* n2 = ws.arena.alloc<double>(n);
+  double* scratch = ws.arena.alloc<double>(n);
+
+  for(std::size_t i = 0; i < n; ++i) {
+    scratch[i] = f1[idx[i]];
+  }
+  double f1med = median_inplace(scratch, n);
+  for(std::size_t i = 0; i < n; ++i) {
+    scratch[i] = f2[idx[i]];
+  }
+  double f2med = median_inplace(scratch, n);
+  for(std::size_t i = 0; i < n; ++i) {
+    n1[i] = (f1[idx[i]] - f1med) / f1med;
+    n2[i] = (f2[idx[i]] - f2med) / f2med;
+  }
+
+  double* density = ws.density.data();
+  double maxDensity = 0;
+  if(smooth) {
+    vsd_density(n2, n1, n, g, m, resolution, kernel, density, ws.bins,
+                ws.tmp);
+    for(std::size_t k = 0; k < ng; ++k) {
+      if(density[k] > maxDensity) maxDensity = density[k];
+    }
+  } else {
+    vsd_point_grid(n2, n1, n, lo, hi, m, resolution, ws.index);
+    for(int j = 0; j < m; ++j) {
+      for(int i = 0; i < m; ++i) {
+        std::size_t k = (std::size_t) j * m + i;
+        ws.counts[k] = ws.index.count_within(g[j], g[i], resolution);
+        if(ws.counts[k] > maxDensity) maxDensity = ws.counts[k];
+      }
+    }
+    for(std::size_t k = 0; k < ng; ++k) {
+      density[k] = ws.counts[k];
+    }
+  }
+
+  // Keep the grid points at or above the threshold, as fractions of the
+  // maximum density
+  ws.cell.clear();
+  ws.hx.clear();
+  ws.hy.clear();
+  for(std::size_t k = 0; k < ng; ++k) {
+    if(density[k] / maxDensity >= threshold) {
+      ws.cell.push_back(k);
+      ws.hx.push_back(g[k / m]);
+      ws.hy.push_back(g[k % m]);
+    }
+  }
+
+  res.cells = ws.cell.size();
+  res.hull.clear();
+  if(ws.cell.empty()) {
+    res.area = na_real();
+    res.perimeter = na_real();
+    return;
+  }
+  convex_hull(ws.hx.data(), ws.hy.data(), ws.hx.size(), ws.order, ws.hull);
+  res.area = ws.hull.area;
+  res.perimeter = ws.hull.perimeter;
+  for(std::size_t v = 0; v < ws.hull.vertices.size(); ++v) {
+    res.hull.push_back(ws.cell[ws.hull.vertices[v]]);
+  }
+}
+
+// Computes the VSD of every group (see vsd_of_tokens()). The groups are
+// processed in parallel, and each thread reuses one workspace for all the
+// groups it processes.
+inline void grouped_vsd(const double* f1, const double* f2,
+                        const GroupIndex& gi, const double* g, int m,
+                        double resolution, double threshold, bool smooth,
+                        DensityKernel kernel, int threads,
+                        std::vector<GroupVSD>& out) {
+  int ngroups = gi.ngroups();
+  out.resize(ngroups);
+  double lo = m > 0 ? *std::min_element(g, g + m) : 0;
+  double hi = m > 0 ? *std::max_element(g, g + m) : 0;
+
+#pragma omp parallel num_threads(threads)
+{
+  VSDWorkspace ws;
+#pragma omp for schedule(dynamic)
+  for(int gr = 0; gr < ngroups; ++gr) {
+    vsd_of_tokens(f1, f2, gi.index.data() + gi.offset[gr], gi.size(gr), g, m,
+                  lo, hi, resolution, threshold, smooth, kernel, ws,
+                  out[gr]);
+  }
+}
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef ARTICULATED_VSD_RCPP_H
+#define ARTICULATED_VSD_RCPP_H
+
+#include <Rcpp.h>
+#include <string>
+#include <vector>
+
+#include "parallel.h"
+#include "vsd.h"
+#include "vsd_grouped.h"
+
+// Conversions between the native VSD results and the R objects returned by
+// the VSD functions.
+
+namespace articulated {
+
+// Parses the density method of VSD(): "count", or the name of a kernel
+// with a positive bandwidth. Sets 'smooth' for the kernel methods.
+inline void vsd_method(const std::string& method, double resolution,
+                       bool& smooth, DensityKernel& kernel) {
+  smooth = method != "count";
+  kernel = KERNEL_GAUSSIAN;
+  if(smooth && !density_kernel_from_name(method, kernel)) {
+    Rcpp::stop("Unknown density method \"" + method + "\".");
+  }
+  if(smooth && !(resolution > 0)) {
+    Rcpp::stop("The bandwidth must be positive.");
+  }
+}
+
+// The per-group VSD results as returned by VSD.by(): a table with the
+// number of tokens and retained grid cells and the hull area and perimeter
+// of each group, and a table of the hull vertices, given as 1-based grid
+// point indices and coordinates. Groups are given by their 1-based codes.
+inline Rcpp::List grouped_vsd_list(const GroupIndex& gi,
+                                   const std::vector<GroupVSD>& vsd,
+                                   const double* grid, int m) {
+  using namespace Rcpp;
+  int ngroups = gi.ngroups();
+  IntegerVector vgroup(ngroups), vn(ngroups), vcells(ngroups);
+  NumericVector varea(ngroups), vperimeter(ngroups);
+  int nrows = 0;
+  for(int g = 0; g < ngroups; ++g) {
+    vgroup[g] = g + 1;
+    vn[g] = gi.size(g);
+    vcells[g] = vsd[g].cells;
+    varea[g] = vsd[g].area;
+    vperimeter[g] = vsd[g].perimeter;
+    nrows += vsd[g].hull.size();
+  }
+  IntegerVector hgroup(nrows), hcell(nrows);
+  NumericVector hf2(nrows), hf1(nrows);
+  for(int g = 0, r = 0; g < ngroups; ++g) {
+    for(std::size_t v = 0; v < vsd[g].hull.size(); ++v, ++r) {
+      std::size_t k = vsd[g].hull[v];
+      hgroup[r] = g + 1;
+      hcell[r] = k + 1;
+      hf2[r] = grid[k / m];
+      hf1[r] = grid[k % m];
+    }
+  }
+  DataFrame vsdDF = DataFrame::create(Named("group") = vgroup,
+                                      Named("n") = vn,
+                                      Named("cells") = vcells,
+                                      Named("area") = varea,
+                                      Named("perimeter") = vperimeter);
+  DataFrame hullDF = DataFrame::create(Named("group") = hgroup,
+                                       Named("cell") = hcell,
+                                       Named("F2") = hf2,
+                                       Named("F1") = hf1);
+  return List::create(Named("VSD") = vsdDF, Named("Hull") = hullDF);
+}
+
+} // namespace articulated
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef ARTICULATED_VSD_STREAM_H
+#define ARTICULATED_VSD_STREAM_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "hull.h"
+#include "vowelspace.h"
+#include "vsd.h"
+
+namespace articulated {
+
+// The exact running median of a stream of values, kept in two heaps: the
+// lower half in a max-heap and the upper half in a min-heap. Adding a value
+// is O(log n) and the median O(1). Missing values are skipped.
+class RunningMedian {
+public:
+  void add(double x) {
+    if(std::isnan(x)) return;
+    if(lower.empty() || x <= lower.top()) lower.push(x);
+    else upper.push(x);
+    if(lower.size() > upper.size() + 1) {
+      upper.push(lower.top());
+      lower.pop();
+    } else if(upper.size() > lower.size()) {
+      lower.push(upper.top());
+      upper.pop();
+    }
+  }
+
+  // The median as median() computes it (see median_inplace()).
+  double value() const {
+    if(lower.empty()) return na_real();
+    if(lower.size() > upper.size()) return lower.top();
+    double a = lower.top(), b = upper.top();
+    long double s = ((long double) a + b) / 2;
+    if(std::isfinite((double) s)) {
+      long double t = (a - s) + (b - s);
+      s += t / 2;
+    }
+    return (double) s;
+  }
+
+private:
+  std::priority_queue<double> lower;
+  std::priority_queue<double, std::vector<double>, std::greater<double> > upper;
+};
+
+// A vowel space density that is updated one formant frame at a time.
+//
+// The count grid of VSD() is kept between frames. A new frame is normalised
+// by the reference medians and increments only the grid points within
+// 'resolution' of it. The thresholded hull is recomputed lazily, the first
+// time it is asked for after the counts changed.
+//
+// Recompute policy: the exact running medians of F1 and F2 are updated with
+// every frame. When either of them has drifted from its reference median
+// by more than 'tolerance' (as a fraction of the reference median, which is
+// the unit of the normalised plane), all frames are renormalised by the
+// running medians, which become the new reference, and the count grid is
+// rebuilt from scratch. Directly after a recompute the state is identical to
+// VSD() on all frames seen so far. In between, the counts are those of
+// VSD() with the frames normalised by the reference medians.
+class VSDStream {
+public:
+  // The grid coordinates must be in increasing order.
+  VSDStream(const std::vector<double>& grid, double resolution,
+            double threshold, double tolerance)
+    : g(grid), m((int) grid.size()), resolution(resolution),
+      threshold(threshold), tolerance(tolerance),
+      counts((std::size_t) m * m, 0), maxCount(0), ref1(na_real()),
+      ref2(na_real()), nrecomputes(0), dirty(true) {}
+
+  void add(double f2, double f1) {
+    f2s.push_back(f2);
+    f1s.push_back(f1);
+    med1.add(f1);
+    med2.add(f2);
+    if(std::isnan(f1) || std::isnan(f2)) return;
+
+    if(drifted()) {
+      recompute();
+      return;
+    }
+    increment((f2 - ref2) / ref2, (f1 - ref1) / ref1);
+  }
+
+  // Renormalises all frames by the running medians and rebuilds the counts.
+  void recompute() {
+    ref1 = med1.value();
+    ref2 = med2.value();
+    std::size_t n = f1s.size();
+    n1.resize(n);
+    n2.resize(n);
+    for(std::size_t i = 0; i < n; ++i) {
+      n1[i] = (f1s[i] - ref1) / ref1;
+      n2[i] = (f2s[i] - ref2) / ref2;
+    }
+    if(m > 0) {
+      vsd_point_grid(n2.data(), n1.data(), n, *std::min_element(g.begin(), g.end()),
+                     *std::max_element(g.begin(), g.end()), m, resolution, index);
+    }
+    maxCount = 0;
+    for(int j = 0; j < m; ++j) {
+      for(int i = 0; i < m; ++i) {
+        int c = index.count_within(g[j], g[i], resolution);
+        counts[(std::size_t) j * m + i] = c;
+        if(c > maxCount) maxCount = c;
+      }
+    }
+    ++nrecomputes;
+    dirty = true;
+  }
+
+  // The hull of the grid points at or above the threshold, recomputed if
+  // the counts have changed since it was last asked for. ncells receives the
+  // number of retained grid points. The hull vertices index the retained
+  // points; cell() maps them to grid point indices.
+  const Hull& hull(std::size_t& ncells) {
+    if(dirty) {
+      cells.clear();
+      hx.clear();
+      hy.clear();
+      std::size_t ng = counts.size();
+      for(std::size_t k = 0; k < ng; ++k) {
+        if((double) counts[k] / maxCount >= threshold) {
+          cells.push_back(k);
+          hx.push_back(g[k / m]);
+          hy.push_back(g[k % m]);
+        }
+      }
+      convex_hull(hx.data(), hy.data(), hx.size(), order, cached);
+      dirty = false;
+    }
+    ncells = cells.size();
+    return cached;
+  }
+
+  // The grid point index of the k:th retained grid point.
+  std::size_t cell(std::size_t k) const {
+    return cells[k];
+  }
+
+  double grid(std::size_t k) const {
+    return g[k];
+  }
+
+  int gridSize() const {
+    return m;
+  }
+
+  double median1() const { return med1.value(); }
+  double median2() const { return med2.value(); }
+  double reference1() const { return ref1; }
+  double reference2() const { return ref2; }
+
+  std::size_t size() const {
+    return f1s.size();
+  }
+
+  std::size_t recomputes() const {
+    return nrecomputes;
+  }
+
+private:
+  std::vector<double> g;
+  int m;
+  double resolution, threshold, tolerance;
+
+  // All frames seen so far, needed for recomputing
+  std::vector<double> f1s, f2s;
+  RunningMedian med1, med2;
+
+  std::vector<int> counts;
+  int maxCount;
+  double ref1, ref2;
+  std::size_t nrecomputes;
+
+  // Scratch space for recomputing, kept between recomputes
+  std::vector<double> n1, n2;
+  PointGrid index;
+
+  // The lazily computed hull
+  bool dirty;
+  std::vector<std::size_t> cells, order;
+  std::vector<double> hx, hy;
+  Hull cached;
+
+  bool drifted() const {
+    if(std::isnan(ref1) || std::isnan(ref2)) return true;
+    return std::fabs(med1.value() - ref1) > tolerance * std::fabs(ref1) ||
+      std::fabs(med2.value() - ref2) > tolerance * std::fabs(ref2);
+  }
+
+  // Increments the grid points within the resolution of a normalised frame.
+  // The candidate range is widened by a margin, and every candidate is
+  // tested exactly as in vsd_counts().
+  void increment(double x, double y) {
+    double margin = resolution * (1 + 1e-9) + 1e-12;
+    std::size_t j0 = std::lower_bound(g.begin(), g.end(), x - margin) - g.begin();
+    std::size_t j1 = std::upper_bound(g.begin(), g.end(), x + margin) - g.begin();
+    std::size_t i0 = std::lower_bound(g.begin(), g.end(), y - margin) - g.begin();
+    std::size_t i1 = std::upper_bound(g.begin(), g.end(), y + margin) - g.begin();
+    for(std::size_t j = j0; j < j1; ++j) {
+      for(std::size_t i = i0; i < i1; ++i) {
+        double dx = x - g[j];
+        double dy = y - g[i];
+        if(std::sqrt(dx * dx + dy * dy) <= resolution) {
+          int& c = counts[j * m + i];
+          if(++c > maxCount) maxCount = c;
+          dirty = true;
+        }
+      }
+    }
+  }
+};
+
+} // namespace articulated
+
+#endif
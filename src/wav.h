@@ -0,0 +1,210 @@
+#ifndef ARTICULATED_WAV_H
+#define ARTICULATED_WAV_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// A reader of RIFF/WAVE files, returning the sound as mono samples in
+// [-1, 1]. Integer PCM of 8, 16, 24 and 32 bits and IEEE floats of 32 and
+// 64 bits are supported, also when given in a WAVE_FORMAT_EXTENSIBLE
+// header. Multichannel sound is mixed down by averaging the channels.
+//
+// The file is read in blocks, so that arbitrarily long recordings can be
+// processed in constant memory.
+
+namespace articulated {
+
+class WavReader {
+public:
+  WavReader()
+    : file(0), format(0), nchannels(0), bits(0), samplerate(0), align(0),
+      dataStart(0), nframes(0), position(0) {}
+
+  ~WavReader() {
+    close();
+  }
+
+  // Opens a file and parses its header. Returns false and sets 'error' if
+  // the file cannot be read or is not a supported WAVE file.
+  bool open(const std::string& path, std::string& error) {
+    close();
+    file = std::fopen(path.c_str(), "rb");
+    if(!file) {
+      error = "Could not open the file " + path + ".";
+      return false;
+    }
+    if(!parse_header(error)) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+    if(file) std::fclose(file);
+    file = 0;
+  }
+
+  // Reads up to max sample frames, mixed down to mono, into out. Returns
+  // the number of frames read, which is 0 at the end of the data.
+  std::size_t read(double* out, std::size_t max) {
+    std::size_t m = std::min<std::uint64_t>(max, nframes - position);
+    if(m == 0) return 0;
+    raw.resize(m * align);
+    m = std::fread(raw.data(), align, m, file);
+    const unsigned char* p = raw.data();
+    int bytes = bits / 8;
+    for(std::size_t i = 0; i < m; ++i) {
+      double sum = 0;
+      for(int c = 0; c < nchannels; ++c) {
+        sum += decode(p);
+        p += bytes;
+      }
+      out[i] = sum / nchannels;
+    }
+    position += m;
+    return m;
+  }
+
+  // Starts over from the first sample frame.
+  void rewind() {
+    std::fseek(file, (long) dataStart, SEEK_SET);
+    position = 0;
+  }
+
+  double rate() const {
+    return samplerate;
+  }
+
+  int channels() const {
+    return nchannels;
+  }
+
+  // The level (dB) of full scale on the scale of the stored integer
+  // samples, 20 log10(2^(bits - 1)), which is the scale on which levels were
+  // traditionally reported (as by wrassp::rmsana()). Float files, which
+  // have no such scale, are taken as 16 bit.
+  double full_scale_db() const {
+    int b = format == 3 ? 16 : bits;
+    return 20 * std::log10(std::ldexp(1.0, b - 1));
+  }
+
+  // The number of sample frames in the file, by the header but no more
+  // than the file holds
+  std::uint64_t frames() const {
+    return nframes;
+  }
+
+private:
+  std::FILE* file;
+  int format, nchannels, bits;
+  double samplerate;
+  std::size_t align;
+  std::uint64_t dataStart, nframes, position;
+  std::vector<unsigned char> raw;
+
+  WavReader(const WavReader&);
+  WavReader& operator=(const WavReader&);
+
+  static std::uint32_t le32(const unsigned char* p) {
+    return (std::uint32_t) p[0] | ((std::uint32_t) p[1] << 8) |
+      ((std::uint32_t) p[2] << 16) | ((std::uint32_t) p[3] << 24);
+  }
+
+  static std::uint16_t le16(const unsigned char* p) {
+    return (std::uint16_t) (p[0] | (p[1] << 8));
+  }
+
+  bool parse_header(std::string& error) {
+    unsigned char head[12];
+    if(std::fread(head, 1, 12, file) != 12 || std::memcmp(head, "RIFF", 4) != 0 ||
+       std::memcmp(head + 8, "WAVE", 4) != 0) {
+      error = "Not a RIFF/WAVE file.";
+      return false;
+    }
+    bool haveFormat = false;
+    unsigned char chunk[8];
+    while(std::fread(chunk, 1, 8, file) == 8) {
+      std::uint32_t size = le32(chunk + 4);
+      if(std::memcmp(chunk, "fmt ", 4) == 0) {
+        if(size < 16) break;
+        std::vector<unsigned char> fmt(size);
+        if(std::fread(fmt.data(), 1, size, file) != size) break;
+        format = le16(fmt.data());
+        nchannels = le16(fmt.data() + 2);
+        samplerate = le32(fmt.data() + 4);
+        align = le16(fmt.data() + 12);
+        bits = le16(fmt.data() + 14);
+        // WAVE_FORMAT_EXTENSIBLE keeps the format in its sub-format GUID
+        if(format == 0xFFFE && size >= 26) format = le16(fmt.data() + 24);
+        haveFormat = true;
+        if(size % 2) std::fseek(file, 1, SEEK_CUR);
+      } else if(std::memcmp(chunk, "data", 4) == 0) {
+        if(!haveFormat) break;
+        if(!((format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+             (format == 3 && (bits == 32 || bits == 64)))) {
+          error = "Only integer PCM of 8, 16, 24 or 32 bits and 32 or 64 bit floats are supported.";
+          return false;
+        }
+        if(nchannels < 1 || align != (std::size_t) nchannels * bits / 8 ||
+           !(samplerate > 0)) {
+          error = "The WAVE header is inconsistent.";
+          return false;
+        }
+        dataStart = (std::uint64_t) std::ftell(file);
+        // Recorders that are interrupted, or that write to a pipe, leave a
+        // placeholder size (often 0xFFFFFFFF), so the size is capped by what
+        // the file actually holds.
+        std::fseek(file, 0, SEEK_END);
+        std::uint64_t end = (std::uint64_t) std::ftell(file);
+        std::fseek(file, (long) dataStart, SEEK_SET);
+        nframes = std::min<std::uint64_t>(size, end - dataStart) / align;
+        position = 0;
+        return true;
+      } else {
+        std::fseek(file, (long) size + (size % 2), SEEK_CUR);
+      }
+    }
+    error = "The WAVE file lacks a format or data chunk.";
+    return false;
+  }
+
+  double decode(const unsigned char* p) const {
+    if(format == 3) {
+      if(bits == 32) {
+        std::uint32_t u = le32(p);
+        float f;
+        std::memcpy(&f, &u, 4);
+        return f;
+      }
+      std::uint64_t u = le32(p) | ((std::uint64_t) le32(p + 4) << 32);
+      double d;
+      std::memcpy(&d, &u, 8);
+      return d;
+    }
+    switch(bits) {
+    case 8:
+      return (p[0] - 128) / 128.0;
+    case 16:
+      return (std::int16_t) le16(p) / 32768.0;
+    case 24: {
+      std::int32_t v = (std::int32_t) ((std::uint32_t) p[0] << 8 |
+                                       (std::uint32_t) p[1] << 16 |
+                                       (std::uint32_t) p[2] << 24) >> 8;
+      return v / 8388608.0;
+    }
+    default:
+      return (std::int32_t) le32(p) / 2147483648.0;
+    }
+  }
+};
+
+} // namespace articulated
+
+#endif